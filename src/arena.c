@@ -0,0 +1,111 @@
+#include "include/raylib.h"
+#include "mapObjects.h"
+#include "circles.h"
+#include "arena.h"
+#define MEM_TAG MEM_ARENA
+#include "memtrack.h"
+#include <stdlib.h>
+#include <string.h>
+
+//----------------------------------------------------------------------------------
+// Some Defines
+//----------------------------------------------------------------------------------
+#define ARENA_ALIGN             16
+#define ARENA_SLACK             (64 * 1024)     // Room for transient lists nobody sized yet
+
+// Fruit candidates (CalcFruitCollision) and visible fruit (PublishGameState) are the largest per step lists,
+// FOOD_ITEMS ints each. There is room for both at once so a future caller nesting them can't run out, and
+// CalcFruitCollision falls back to a full scan if it ever does. The snake is drawn from the frame arena
+#define SIM_ARENA_SIZE          (2 * FOOD_ITEMS * sizeof(int) + ARENA_SLACK)
+#define FRAME_ARENA_SIZE        (SNAKE_LENGTH * sizeof(CircleInstance) + ARENA_SLACK)
+
+//----------------------------------------------------------------------------------
+// Global Variables Definition
+//----------------------------------------------------------------------------------
+MemArena simArena = { 0 };
+MemArena frameArena = { 0 };
+MemArena worldArena = { 0 };
+
+//----------------------------------------------------------------------------------
+// Arena Functions Definition
+//----------------------------------------------------------------------------------
+void InitArenas(void)
+{
+    simArena = LoadArena("sim", SIM_ARENA_SIZE);
+    frameArena = LoadArena("frame", FRAME_ARENA_SIZE);
+}
+
+// The world arena depends on the map size, it is (re)created once the map dimensions are known
+void InitWorldArena(size_t mapBytes)
+{
+    UnloadArena(&worldArena);
+    worldArena = LoadArena("world", mapBytes + ARENA_SLACK);
+}
+
+void UnloadArenas(void)
+{
+    UnloadArena(&simArena);
+    UnloadArena(&frameArena);
+    UnloadArena(&worldArena);
+}
+
+MemArena LoadArena(const char *name, size_t capacity)
+{
+    MemArena arena = { 0 };
+
+    arena.name = name;
+    arena.base = (unsigned char *)RL_MALLOC(capacity);
+    if (arena.base != NULL) arena.capacity = capacity;
+
+    return arena;
+}
+
+void UnloadArena(MemArena *arena)
+{
+    if (arena->base == NULL) return;
+
+    TraceLog(LOG_INFO, "ARENA: [%s] High-water %zu of %zu bytes%s", arena->name, arena->highWater, arena->capacity,
+             (arena->failures > 0) ? TextFormat(", %u allocations did not fit", arena->failures) : "");
+
+    RL_FREE(arena->base);
+    *arena = (MemArena){ 0 };
+}
+
+void *ArenaAlloc(MemArena *arena, size_t size)
+{
+    size_t offset = (arena->used + ARENA_ALIGN - 1) & ~(size_t)(ARENA_ALIGN - 1);
+
+    if ((offset > arena->capacity) || (size > arena->capacity - offset))
+    {
+        if (arena->failures++ == 0) TraceLog(LOG_WARNING, "ARENA: [%s] Out of space for %zu bytes, raise its size", arena->name, size);
+        return NULL;
+    }
+
+    arena->used = offset + size;
+    if (arena->used > arena->highWater) arena->highWater = arena->used;
+
+    return arena->base + offset;
+}
+
+void *ArenaCalloc(MemArena *arena, size_t count, size_t size)
+{
+    void *memory = ArenaAlloc(arena, count * size);
+    if (memory != NULL) memset(memory, 0, count * size);
+
+    return memory;
+}
+
+void ResetArena(MemArena *arena)
+{
+    arena->used = 0;
+}
+
+size_t GetArenaMark(const MemArena *arena)
+{
+    return arena->used;
+}
+
+void ResetArenaToMark(MemArena *arena, size_t mark)
+{
+    if (mark < arena->used) arena->used = mark;
+}
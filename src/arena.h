@@ -0,0 +1,39 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stddef.h>
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+// Linear allocator over one fixed block, freed all at once by ResetArena()
+typedef struct MemArena {
+    const char *name;
+    unsigned char *base;
+    size_t capacity;
+    size_t used;
+    size_t highWater;                   // Most ever used between resets, size the arena from this
+    unsigned int failures;              // Allocations that did not fit
+} MemArena;
+
+//----------------------------------------------------------------------------------
+// Global Variables Definition
+//----------------------------------------------------------------------------------
+extern MemArena simArena;               // Simulation thread, reset every simulation step
+extern MemArena frameArena;             // Main thread, reset every drawn frame
+extern MemArena worldArena;             // Lives as long as the loaded map
+
+//----------------------------------------------------------------------------------
+// Arena Functions Declaration
+//----------------------------------------------------------------------------------
+void InitArenas(void);                  // Allocates the blocks once, nothing is malloc'd after that
+void InitWorldArena(size_t mapBytes);   // Sized per map, mapBytes is what the map itself takes from it
+void UnloadArenas(void);                // Logs the high-water marks
+MemArena LoadArena(const char *name, size_t capacity);
+void UnloadArena(MemArena *arena);
+void *ArenaAlloc(MemArena *arena, size_t size);                 // ARENA_ALIGN aligned, NULL when full
+void *ArenaCalloc(MemArena *arena, size_t count, size_t size);
+void ResetArena(MemArena *arena);
+size_t GetArenaMark(const MemArena *arena);                     // Scratch lists: take a mark...
+void ResetArenaToMark(MemArena *arena, size_t mark);            // ...and give everything after it back
+
+#endif
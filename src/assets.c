@@ -0,0 +1,542 @@
+#include "include/raylib.h"
+#include "include/rlgl.h"
+#include "atlas.h"
+#include "pak.h"
+#include "watch.h"
+#include "profile.h"
+#include "assets.h"
+#define MEM_TAG MEM_ASSETS
+#include "memtrack.h"
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+#if !defined(PLATFORM_WEB)
+    #include <pthread.h>
+    #define ASSETS_THREADED         // Images are decoded by a background worker thread
+#endif
+
+//----------------------------------------------------------------------------------
+// Some Defines
+//----------------------------------------------------------------------------------
+#define ASSET_PATH_SIZE         512
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+typedef enum AssetState { ASSET_FREE = 0, ASSET_QUEUED, ASSET_DECODED, ASSET_READY } AssetState;
+typedef enum AssetType { ASSET_TEXTURE = 0, ASSET_ATLAS } AssetType;
+
+typedef struct Asset {
+    AssetType type;
+    int flags;
+    const char **fileNames;     // Atlas sprites
+    const char *fileName;       // Texture file, or atlas name in the pak
+    int fileCount;
+    int refCount;
+    bool reloading;             // Source files changed, decode them again ignoring the pak
+    int watches[ATLAS_MAX_SPRITES];
+    int watchCount;
+
+    // Written by the decoder, taken over on upload
+    Image image;
+    bool imageInPak;            // Image data points into the pak, not to be unloaded
+    Vector2 imageSize;
+    TextureAtlas layout;
+
+    // Main thread only
+    Vector2 sourceSize;
+    Texture2D texture;
+    TextureAtlas atlas;
+    unsigned int version;
+} Asset;
+
+//----------------------------------------------------------------------------------
+// Module Variables Definition (local)
+//----------------------------------------------------------------------------------
+static Asset assets[ASSET_MAX] = { 0 };
+static unsigned char assetState[ASSET_MAX] = { 0 };    // Protected by workerMutex when threaded
+static bool assetReady[ASSET_MAX] = { 0 };              // Main thread copy of ASSET_READY, read without locking
+static int decodeQueue[ASSET_MAX] = { 0 };
+static int decodeHead = 0;
+static int decodeCount = 0;
+static Pak pak = { 0 };         // Read only between InitAssets() and UnloadAssets(), shared with the worker
+static char assetRoot[ASSET_PATH_SIZE] = { 0 };     // Set before the worker starts, read only after that
+
+#if defined(ASSETS_THREADED)
+static pthread_t workerThread;
+static pthread_mutex_t workerMutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t workerWake = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t workerDone = PTHREAD_COND_INITIALIZER;
+static bool workerRunning = false;
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition (local)
+//----------------------------------------------------------------------------------
+static const char *GetAssetRoot(void)
+{
+    if (assetRoot[0] != '\0') return assetRoot;
+
+#if defined(PLATFORM_WEB)
+    // Resources are preloaded into the virtual file system, the working directory is its root
+    const char *directory = "";
+#else
+    const char *directory = GetApplicationDirectory();
+#endif
+    int length = snprintf(assetRoot, sizeof(assetRoot), "%s%s", directory, ASSET_ROOT);
+    if ((length < 0) || (length >= (int)sizeof(assetRoot)))
+    {
+        TraceLog(LOG_WARNING, "ASSETS: Application directory too long, assets are loaded relative to the working directory");
+        snprintf(assetRoot, sizeof(assetRoot), "%s", ASSET_ROOT);
+    }
+
+    return assetRoot;
+}
+
+static void UnloadAssetImage(Asset *asset)
+{
+    if (!asset->imageInPak) UnloadImage(asset->image);
+    asset->image = (Image){ 0 };
+    asset->imageInPak = false;
+}
+
+static void DecodeAsset(Asset *asset)
+{
+    const PakEntry *entry = asset->reloading ? NULL : FindPakEntry(&pak, asset->fileName);
+
+    if (asset->type == ASSET_ATLAS)
+    {
+        // A prepacked atlas only counts if it was built from the same sprite list
+        if ((entry != NULL) && (entry->sourceHash == HashPakNames(asset->fileNames, asset->fileCount)) && GetPakAtlas(&pak, entry, &asset->layout))
+        {
+            asset->image = GetPakImage(&pak, entry);
+            asset->imageInPak = true;
+        }
+        else
+        {
+            const char *paths[ATLAS_MAX_SPRITES] = { 0 };
+            char pathData[ATLAS_MAX_SPRITES][ASSET_PATH_SIZE];
+            int count = (asset->fileCount < ATLAS_MAX_SPRITES) ? asset->fileCount : ATLAS_MAX_SPRITES;
+
+            for (int i = 0; i < count; i++)
+            {
+                snprintf(pathData[i], sizeof(pathData[i]), "%s%s", assetRoot, asset->fileNames[i]);
+                paths[i] = pathData[i];
+            }
+            asset->image = LoadAtlasImage(paths, count, &asset->layout);
+        }
+        asset->imageSize = (Vector2){ asset->image.width, asset->image.height };
+
+        // Terrain tiles are baked up to 16:1 smaller (see bake.c), mipmaps keep that from aliasing.
+        // Mipmaps are built on the CPU, GL can't generate them for DXT, so the atlas is uploaded uncompressed
+        if (asset->image.data != NULL)
+        {
+            if ((asset->image.format >= PIXELFORMAT_COMPRESSED_DXT1_RGB) || asset->imageInPak)
+            {
+                // Pak data is read only, mipmaps go into a copy
+                Image copy = (asset->image.format >= PIXELFORMAT_COMPRESSED_DXT1_RGB) ? DecompressImageDXT(asset->image) : ImageCopy(asset->image);
+                UnloadAssetImage(asset);
+                asset->image = copy;
+            }
+            ImageMipmaps(&asset->image);
+        }
+        return;
+    }
+
+    if ((entry != NULL) && (entry->type == PAK_IMAGE))
+    {
+        asset->image = GetPakImage(&pak, entry);
+        asset->imageInPak = true;
+    }
+    else
+    {
+        char path[ASSET_PATH_SIZE];
+        snprintf(path, sizeof(path), "%s%s", assetRoot, asset->fileName);
+        asset->image = LoadImage(path);
+    }
+    asset->imageSize = (Vector2){ asset->image.width, asset->image.height };
+
+#if defined(PLATFORM_WEB)
+    // GLES2 can't wrap non power-of-two textures
+    if (asset->flags & ASSET_REPEAT)
+    {
+        int width = 1, height = 1;
+        while (width < asset->image.width) width <<= 1;
+        while (height < asset->image.height) height <<= 1;
+
+        if ((width != asset->image.width) || (height != asset->image.height))
+        {
+            if (asset->image.format >= PIXELFORMAT_COMPRESSED_DXT1_RGB) asset->image = DecompressImageDXT(asset->image);
+            else if (asset->imageInPak) asset->image = ImageCopy(asset->image);
+            asset->imageInPak = false;
+            ImageResize(&asset->image, width, height);
+        }
+    }
+#endif
+}
+
+#if defined(ASSETS_THREADED)
+static void *WorkerThread(void *arg)
+{
+    SetProfileThreadName("assets");
+    pthread_mutex_lock(&workerMutex);
+
+    while (true)
+    {
+        while (workerRunning && (decodeCount == 0)) pthread_cond_wait(&workerWake, &workerMutex);
+        if (!workerRunning) break;
+
+        int id = decodeQueue[decodeHead];
+        decodeHead = (decodeHead + 1) % ASSET_MAX;
+        decodeCount--;
+
+        // The slot belongs to this thread until it is marked decoded
+        pthread_mutex_unlock(&workerMutex);
+        PROFILE_BEGIN("DecodeAsset");
+        DecodeAsset(&assets[id]);
+        PROFILE_END();
+        pthread_mutex_lock(&workerMutex);
+
+        assetState[id] = ASSET_DECODED;
+        pthread_cond_broadcast(&workerDone);
+    }
+
+    pthread_mutex_unlock(&workerMutex);
+
+    return NULL;
+}
+#endif
+
+static bool IsWorkerRunning(void)
+{
+#if defined(ASSETS_THREADED)
+    return workerRunning;
+#else
+    return false;
+#endif
+}
+
+static void LockAssets(void)
+{
+#if defined(ASSETS_THREADED)
+    if (workerRunning) pthread_mutex_lock(&workerMutex);
+#endif
+}
+
+static void UnlockAssets(void)
+{
+#if defined(ASSETS_THREADED)
+    if (workerRunning) pthread_mutex_unlock(&workerMutex);
+#endif
+}
+
+// Same type, flags and files. Main thread only, file names are never written by the worker
+static bool IsSameAsset(const Asset *a, const Asset *b)
+{
+    if ((a->type != b->type) || (a->flags != b->flags) || (strcmp(a->fileName, b->fileName) != 0)) return false;
+    if (a->fileCount != b->fileCount) return false;
+
+    for (int i = 0; i < a->fileCount; i++)
+    {
+        if (strcmp(a->fileNames[i], b->fileNames[i]) != 0) return false;
+    }
+    return true;
+}
+
+// Hand out the cached asset if it was requested before, queue a decode otherwise
+static int QueueAsset(Asset asset)
+{
+    int id = -1;
+
+    for (int i = 0; i < ASSET_MAX; i++)
+    {
+        if ((assets[i].refCount > 0) && IsSameAsset(&assets[i], &asset))
+        {
+            assets[i].refCount++;
+            return i;
+        }
+    }
+
+    // Loose source files are watched even when the pak has the asset, editing them overrides it
+    asset.refCount = 1;
+    for (int i = 0; i < ((asset.type == ASSET_ATLAS) ? asset.fileCount : 1) && (i < ATLAS_MAX_SPRITES); i++)
+    {
+        const char *fileName = (asset.type == ASSET_ATLAS) ? asset.fileNames[i] : asset.fileName;
+        asset.watches[asset.watchCount++] = WatchFile(GetAssetPath(fileName));
+    }
+
+    LockAssets();
+    for (int i = 0; i < ASSET_MAX; i++)
+    {
+        if (assetState[i] == ASSET_FREE)
+        {
+            id = i;
+            break;
+        }
+    }
+
+    if (id >= 0)
+    {
+        assets[id] = asset;
+        assetState[id] = ASSET_QUEUED;
+        decodeQueue[(decodeHead + decodeCount) % ASSET_MAX] = id;
+        decodeCount++;
+#if defined(ASSETS_THREADED)
+        if (workerRunning) pthread_cond_signal(&workerWake);
+#endif
+    }
+    UnlockAssets();
+
+    if (id < 0)
+    {
+        TraceLog(LOG_WARNING, "ASSETS: Asset table full, request dropped");
+        for (int i = 0; i < asset.watchCount; i++) UnwatchFile(asset.watches[i]);
+    }
+
+    return id;
+}
+
+// Decode again, the current texture stays in use until the new one is uploaded
+static void ReloadChangedAssets(void)
+{
+    for (int i = 0; i < ASSET_MAX; i++)
+    {
+        if (!assetReady[i]) continue;
+
+        bool changed = false;
+        for (int w = 0; w < assets[i].watchCount; w++) changed |= IsFileChanged(assets[i].watches[w]);
+        if (!changed) continue;
+
+        TraceLog(LOG_INFO, "ASSETS: [%s] Source changed, reloading", assets[i].fileName);
+
+        LockAssets();
+        if (assetState[i] == ASSET_READY)
+        {
+            assets[i].reloading = true;
+            assetState[i] = ASSET_QUEUED;
+            decodeQueue[(decodeHead + decodeCount) % ASSET_MAX] = i;
+            decodeCount++;
+#if defined(ASSETS_THREADED)
+            if (workerRunning) pthread_cond_signal(&workerWake);
+#endif
+        }
+        UnlockAssets();
+    }
+}
+
+static Texture2D GetPlaceholderTexture(void)
+{
+    return (Texture2D){ rlGetTextureIdDefault(), 1, 1, 1, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8 };
+}
+
+//----------------------------------------------------------------------------------
+// Asset Manager Functions Definition
+//----------------------------------------------------------------------------------
+void InitAssets(void)
+{
+    GetAssetRoot();     // Resolved once here, the worker reads assetRoot without locking
+    if (pak.data == NULL) pak = LoadPak(GetAssetPath(ASSET_PAK_FILE));
+
+#if defined(ASSETS_THREADED)
+    if (workerRunning) return;
+
+    workerRunning = true;
+    if (pthread_create(&workerThread, NULL, WorkerThread, NULL) != 0)
+    {
+        TraceLog(LOG_ERROR, "ASSETS: Failed to start decode thread, decoding on the main thread");
+        workerRunning = false;
+    }
+#endif
+}
+
+void UnloadAssets(void)
+{
+#if defined(ASSETS_THREADED)
+    if (workerRunning)
+    {
+        pthread_mutex_lock(&workerMutex);
+        workerRunning = false;
+        pthread_cond_signal(&workerWake);
+        pthread_mutex_unlock(&workerMutex);
+        pthread_join(workerThread, NULL);
+    }
+#endif
+
+    // Nothing is decoding anymore, queued assets are just dropped
+    for (int i = 0; i < ASSET_MAX; i++)
+    {
+        if (assets[i].refCount <= 0) continue;
+
+        TraceLog(LOG_WARNING, "ASSETS: [%i] Still referenced at shutdown (%i)", i, assets[i].refCount);
+        assets[i].refCount = 1;
+        UnloadAsset(i);
+    }
+    decodeHead = decodeCount = 0;
+
+    UnloadPak(pak);
+    pak = (Pak){ 0 };
+}
+
+void UpdateAssets(void)
+{
+    ReloadChangedAssets();
+
+    // Without a worker decode one asset per frame, so the first frames still come up quickly
+    if (!IsWorkerRunning() && (decodeCount > 0))
+    {
+        int id = decodeQueue[decodeHead];
+        decodeHead = (decodeHead + 1) % ASSET_MAX;
+        decodeCount--;
+        DecodeAsset(&assets[id]);
+        assetState[id] = ASSET_DECODED;
+    }
+
+    bool decoded[ASSET_MAX] = { 0 };
+    LockAssets();
+    for (int i = 0; i < ASSET_MAX; i++) decoded[i] = (assetState[i] == ASSET_DECODED);
+    UnlockAssets();
+
+    // Decoded assets belong to the main thread, upload them within the frame budget
+    int uploaded = 0;
+    for (int i = 0; (i < ASSET_MAX) && (uploaded < ASSET_UPLOAD_BUDGET); i++)
+    {
+        if (!decoded[i]) continue;
+
+        Asset *asset = &assets[i];
+        Texture2D texture = LoadTextureFromImage(asset->image);
+        if ((texture.id == 0) && (asset->image.format >= PIXELFORMAT_COMPRESSED_DXT1_RGB))
+        {
+            // No S3TC on this GPU, decompress on the CPU
+            Image decompressed = DecompressImageDXT(asset->image);
+            UnloadAssetImage(asset);
+            asset->image = decompressed;
+            texture = LoadTextureFromImage(asset->image);
+        }
+        if (asset->flags & ASSET_REPEAT) SetTextureWrap(texture, TEXTURE_WRAP_REPEAT);
+        if (asset->type == ASSET_ATLAS) SetTextureFilter(texture, TEXTURE_FILTER_TRILINEAR);
+
+        // Replaces the previous texture when reloading, unless the new file didn't load (e.g. half written)
+        if ((texture.id == 0) && (asset->texture.id > 0)) TraceLog(LOG_WARNING, "ASSETS: [%s] Reload failed, keeping the previous texture", asset->fileName);
+        else
+        {
+            if (asset->texture.id > 0) UnloadTexture(asset->texture);
+            asset->texture = texture;
+            asset->sourceSize = asset->imageSize;
+            if (asset->type == ASSET_ATLAS)
+            {
+                asset->atlas = asset->layout;
+                asset->atlas.texture = texture;
+            }
+            asset->version++;
+        }
+        asset->reloading = false;
+
+        uploaded += GetPixelDataSize(asset->image.width, asset->image.height, asset->image.format);
+        UnloadAssetImage(asset);
+
+        LockAssets();
+        assetState[i] = ASSET_READY;
+        UnlockAssets();
+        assetReady[i] = true;
+    }
+}
+
+const char *GetAssetPath(const char *fileName)
+{
+    return TextFormat("%s%s", GetAssetRoot(), fileName);
+}
+
+int RequestTexture(const char *fileName, int flags)
+{
+    return QueueAsset((Asset){ .type = ASSET_TEXTURE, .flags = flags, .fileName = fileName });
+}
+
+int RequestAtlas(const char *name, const char **fileNames, int count)
+{
+    return QueueAsset((Asset){ .type = ASSET_ATLAS, .fileName = name, .fileNames = fileNames, .fileCount = count });
+}
+
+// Drop one reference, the last one frees the asset (waiting for the worker if it is still decoding)
+void UnloadAsset(int asset)
+{
+    if ((asset < 0) || (asset >= ASSET_MAX) || (assets[asset].refCount <= 0)) return;
+    if (--assets[asset].refCount > 0) return;
+
+    LockAssets();
+#if defined(ASSETS_THREADED)
+    while (workerRunning && (assetState[asset] == ASSET_QUEUED)) pthread_cond_wait(&workerDone, &workerMutex);
+#endif
+    int state = assetState[asset];
+    UnlockAssets();
+
+    if (state == ASSET_QUEUED)
+    {
+        // Only reachable without a worker: take it out of the queue
+        for (int i = 0; i < decodeCount; i++)
+        {
+            if (decodeQueue[(decodeHead + i) % ASSET_MAX] != asset) continue;
+            for (int j = i; j < decodeCount - 1; j++) decodeQueue[(decodeHead + j) % ASSET_MAX] = decodeQueue[(decodeHead + j + 1) % ASSET_MAX];
+            decodeCount--;
+            break;
+        }
+    }
+    else if (state == ASSET_DECODED) UnloadAssetImage(&assets[asset]);
+
+    // Also set while a reload is pending
+    if (assets[asset].texture.id > 0) UnloadTexture(assets[asset].texture);
+    for (int i = 0; i < assets[asset].watchCount; i++) UnwatchFile(assets[asset].watches[i]);
+
+    assets[asset] = (Asset){ 0 };
+    assetReady[asset] = false;
+    LockAssets();
+    assetState[asset] = ASSET_FREE;
+    UnlockAssets();
+}
+
+bool IsAssetReady(int asset)
+{
+    return (asset >= 0) && (asset < ASSET_MAX) && assetReady[asset];
+}
+
+Texture2D GetAssetTexture(int asset)
+{
+    if (!IsAssetReady(asset)) return GetPlaceholderTexture();
+    return assets[asset].texture;
+}
+
+// Placeholder atlas maps every sprite onto the white texel
+TextureAtlas GetAssetAtlas(int asset)
+{
+    if (IsAssetReady(asset)) return assets[asset].atlas;
+
+    TextureAtlas atlas = { 0 };
+    atlas.texture = GetPlaceholderTexture();
+    atlas.white = (Rectangle){ 0, 0, 1, 1 };
+    for (int i = 0; i < ATLAS_MAX_SPRITES; i++)
+    {
+        atlas.sprites[i] = atlas.white;
+        atlas.averages[i] = GRAY;
+    }
+
+    return atlas;
+}
+
+int GetPendingAssets(void)
+{
+    int pending = 0;
+    for (int i = 0; i < ASSET_MAX; i++) if ((assets[i].refCount > 0) && !assetReady[i]) pending++;
+    return pending;
+}
+
+unsigned int GetAssetVersion(int asset)
+{
+    if (!IsAssetReady(asset)) return 0;
+    return assets[asset].version;
+}
+
+Vector2 GetAssetSourceSize(int asset)
+{
+    if (!IsAssetReady(asset)) return (Vector2){ 1.0f, 1.0f };
+    return assets[asset].sourceSize;
+}
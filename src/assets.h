@@ -0,0 +1,39 @@
+#ifndef ASSETS_H
+#define ASSETS_H
+//----------------------------------------------------------------------------------
+// Some Defines
+//----------------------------------------------------------------------------------
+#define ASSET_MAX               32
+#define ASSET_UPLOAD_BUDGET     (8*1024*1024)   // Bytes uploaded to the GPU per frame, at least one asset always goes
+
+#define ASSET_ROOT              "../resources/"     // Asset names are relative to it, it is relative to the executable
+#define ASSET_PAK_FILE          "assets.pak"        // Under ASSET_ROOT
+
+#define ASSET_REPEAT            1       // Texture flag: set wrap mode to repeat (resized to power-of-two on GLES2)
+
+//----------------------------------------------------------------------------------
+// Asset Manager Functions Declaration
+//----------------------------------------------------------------------------------
+// Images are decoded on a worker thread and uploaded by UpdateAssets(), getters return a placeholder
+// (1x1 white texture) until then. Assets are cached by file name and reference counted: requesting
+// the same files again returns the same id, every request needs its UnloadAsset().
+// Names are looked up in ASSET_PAK_FILE first (see pakgen), loose files under ASSET_ROOT otherwise.
+// ASSET_ROOT is resolved against GetApplicationDirectory(), so the game starts from any working directory.
+// File name strings must stay valid until the asset is unloaded.
+void InitAssets(void);                  // Call after InitWindow()
+void UnloadAssets(void);
+void UpdateAssets(void);                // Once per frame on the main thread, uploads decoded images
+const char *GetAssetPath(const char *fileName); // Full path of a file under ASSET_ROOT, TextFormat() string (main thread)
+
+int RequestTexture(const char *fileName, int flags);            // Returns asset id, -1 if the table is full
+int RequestAtlas(const char *name, const char **fileNames, int count);  // Name of the prepacked atlas in the pak
+void UnloadAsset(int asset);            // Releases one reference
+
+bool IsAssetReady(int asset);
+int GetPendingAssets(void);             // Requested but not uploaded yet
+unsigned int GetAssetVersion(int asset);    // Bumped on every upload, source files are watched and reloaded
+Texture2D GetAssetTexture(int asset);
+TextureAtlas GetAssetAtlas(int asset);
+Vector2 GetAssetSourceSize(int asset);  // Image size as decoded, before any power-of-two resize
+
+#endif
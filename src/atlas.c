@@ -0,0 +1,188 @@
+#include "include/raylib.h"
+#include "atlas.h"
+#define MEM_TAG MEM_ASSETS
+#include "memtrack.h"
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition (local)
+//----------------------------------------------------------------------------------
+// Place images in shelves (tallest first) inside a given width, returns the used height
+static int LayoutShelves(const Image *images, const int *order, int count, int width, Rectangle *rects)
+{
+    int x = ATLAS_PADDING;
+    int y = ATLAS_PADDING;
+    int shelfHeight = 0;
+
+    for (int i = 0; i < count; i++)
+    {
+        const Image *image = &images[order[i]];
+        if (ATLAS_PADDING + image->width + ATLAS_PADDING > width) return -1;
+
+        if (x + image->width + ATLAS_PADDING > width)
+        {
+            x = ATLAS_PADDING;
+            y += shelfHeight;
+            shelfHeight = 0;
+        }
+
+        rects[order[i]] = (Rectangle){ x, y, image->width, image->height };
+        x += image->width + ATLAS_PADDING;
+        if (image->height + ATLAS_PADDING > shelfHeight) shelfHeight = image->height + ATLAS_PADDING;
+    }
+
+    return y + shelfHeight;
+}
+
+static Color GetImageAverage(Image image)
+{
+    Color *pixels = LoadImageColors(image);
+    int count = image.width * image.height;
+    unsigned long long sum[4] = { 0 };
+
+    for (int i = 0; i < count; i++)
+    {
+        sum[0] += pixels[i].r;
+        sum[1] += pixels[i].g;
+        sum[2] += pixels[i].b;
+        sum[3] += pixels[i].a;
+    }
+    UnloadImageColors(pixels);
+
+    if (count == 0) return BLANK;
+    return (Color){ sum[0] / count, sum[1] / count, sum[2] / count, sum[3] / count };
+}
+
+// Repeat the sprite's border texels into half the padding around it, filtering and mipmaps
+// then blend a sprite edge with itself instead of its neighbours or the transparent gap
+static void ExtrudeSprite(Image *atlas, Image image, Rectangle rect)
+{
+    float e = ATLAS_PADDING / 2;
+    float w = image.width;
+    float h = image.height;
+
+    ImageDraw(atlas, image, (Rectangle){ 0, 0, w, 1 }, (Rectangle){ rect.x, rect.y - e, w, e }, WHITE);
+    ImageDraw(atlas, image, (Rectangle){ 0, h - 1, w, 1 }, (Rectangle){ rect.x, rect.y + h, w, e }, WHITE);
+    ImageDraw(atlas, image, (Rectangle){ 0, 0, 1, h }, (Rectangle){ rect.x - e, rect.y, e, h }, WHITE);
+    ImageDraw(atlas, image, (Rectangle){ w - 1, 0, 1, h }, (Rectangle){ rect.x + w, rect.y, e, h }, WHITE);
+
+    ImageDraw(atlas, image, (Rectangle){ 0, 0, 1, 1 }, (Rectangle){ rect.x - e, rect.y - e, e, e }, WHITE);
+    ImageDraw(atlas, image, (Rectangle){ w - 1, 0, 1, 1 }, (Rectangle){ rect.x + w, rect.y - e, e, e }, WHITE);
+    ImageDraw(atlas, image, (Rectangle){ 0, h - 1, 1, 1 }, (Rectangle){ rect.x - e, rect.y + h, e, e }, WHITE);
+    ImageDraw(atlas, image, (Rectangle){ w - 1, h - 1, 1, 1 }, (Rectangle){ rect.x + w, rect.y + h, e, e }, WHITE);
+}
+
+static int NextPowerOfTwo(int value)
+{
+    int result = 1;
+    while (result < value) result <<= 1;
+    return result;
+}
+
+//----------------------------------------------------------------------------------
+// Atlas Functions Definition
+//----------------------------------------------------------------------------------
+// Pack images into one power-of-two RGBA image, choosing the smallest atlas that fits
+Image PackAtlasImage(const Image *images, int count, Rectangle *rects)
+{
+    int order[ATLAS_MAX_SPRITES] = { 0 };
+    Rectangle layout[ATLAS_MAX_SPRITES] = { 0 };
+    int bestWidth = 0;
+    int bestHeight = 0;
+
+    if (count > ATLAS_MAX_SPRITES) count = ATLAS_MAX_SPRITES;
+
+    // Tallest first keeps shelves tight
+    for (int i = 0; i < count; i++)
+    {
+        int j = i;
+        while ((j > 0) && (images[order[j - 1]].height < images[i].height))
+        {
+            order[j] = order[j - 1];
+            j--;
+        }
+        order[j] = i;
+    }
+
+    for (int width = 64; width <= ATLAS_MAX_SIZE; width <<= 1)
+    {
+        int usedHeight = LayoutShelves(images, order, count, width, layout);
+        if (usedHeight < 0) continue;
+
+        int height = NextPowerOfTwo(usedHeight);
+        if ((height > ATLAS_MAX_SIZE) || (height > width*2)) continue;
+
+        if ((bestWidth == 0) || (width * height < bestWidth * bestHeight))
+        {
+            bestWidth = width;
+            bestHeight = height;
+            for (int i = 0; i < count; i++) rects[i] = layout[i];
+        }
+    }
+
+    if (bestWidth == 0)
+    {
+        TraceLog(LOG_WARNING, "ATLAS: Images don't fit in a %ix%i atlas", ATLAS_MAX_SIZE, ATLAS_MAX_SIZE);
+        return (Image){ 0 };
+    }
+
+    Image atlas = GenImageColor(bestWidth, bestHeight, BLANK);
+    for (int i = 0; i < count; i++)
+    {
+        ImageDraw(&atlas, images[i], (Rectangle){ 0, 0, images[i].width, images[i].height }, rects[i], WHITE);
+        ExtrudeSprite(&atlas, images[i], rects[i]);
+    }
+
+    return atlas;
+}
+
+// Load images and pack them into one image, plus a white patch for shapes. CPU only, so any thread
+// can call it, atlas.texture is left for the caller to upload
+Image LoadAtlasImage(const char **fileNames, int count, TextureAtlas *atlas)
+{
+    Image images[ATLAS_MAX_SPRITES] = { 0 };
+    Rectangle rects[ATLAS_MAX_SPRITES] = { 0 };
+
+    if (count > ATLAS_MAX_SPRITES - 1) count = ATLAS_MAX_SPRITES - 1;
+
+    for (int i = 0; i < count; i++) images[i] = LoadImage(fileNames[i]);
+    images[count] = GenImageColor(4, 4, WHITE);
+
+    Image packed = PackAtlasImage(images, count + 1, rects);
+    *atlas = (TextureAtlas){ 0 };
+    atlas->count = count;
+    for (int i = 0; i < count; i++)
+    {
+        atlas->sprites[i] = rects[i];
+        atlas->averages[i] = GetImageAverage(images[i]);
+    }
+
+    // Inner texels only, so filtering never picks up the transparent padding
+    atlas->white = (Rectangle){ rects[count].x + 1, rects[count].y + 1, 2, 2 };
+
+    for (int i = 0; i <= count; i++) UnloadImage(images[i]);
+
+    return packed;
+}
+
+TextureAtlas LoadTextureAtlas(const char **fileNames, int count)
+{
+    TextureAtlas atlas = { 0 };
+    Image packed = LoadAtlasImage(fileNames, count, &atlas);
+
+    atlas.texture = LoadTextureFromImage(packed);
+    UnloadImage(packed);
+
+    TraceLog(LOG_INFO, "ATLAS: Packed %i sprites into %ix%i texture", atlas.count, atlas.texture.width, atlas.texture.height);
+
+    return atlas;
+}
+
+void UnloadTextureAtlas(TextureAtlas atlas)
+{
+    UnloadTexture(atlas.texture);
+}
+
+void DrawAtlasSprite(const TextureAtlas *atlas, int sprite, Rectangle dest, Color tint)
+{
+    DrawTexturePro(atlas->texture, atlas->sprites[sprite], dest, (Vector2){ 0.0f, 0.0f }, 0.0f, tint);
+}
@@ -0,0 +1,31 @@
+#ifndef ATLAS_H
+#define ATLAS_H
+//----------------------------------------------------------------------------------
+// Some Defines
+//----------------------------------------------------------------------------------
+#define ATLAS_MAX_SPRITES   32
+#define ATLAS_PADDING       16      // Gap around sprites, filled with their edge texels. Multiple of 16 so sprites
+                                    // sized in multiples of 16 stay aligned to mipmap texels down to 1/16
+#define ATLAS_MAX_SIZE      8192
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+typedef struct TextureAtlas {
+    Texture2D texture;
+    Rectangle sprites[ATLAS_MAX_SPRITES];   // Source rectangle of every packed image, in load order
+    Rectangle white;                        // Opaque white texels, used as shapes texture
+    Color averages[ATLAS_MAX_SPRITES];      // Mean color of every sprite, for far away levels of detail
+    int count;
+} TextureAtlas;
+
+//----------------------------------------------------------------------------------
+// Atlas Functions Declaration
+//----------------------------------------------------------------------------------
+Image PackAtlasImage(const Image *images, int count, Rectangle *rects);    // Shelf packer, also usable offline
+Image LoadAtlasImage(const char **fileNames, int count, TextureAtlas *atlas);  // CPU half of LoadTextureAtlas(), thread safe
+TextureAtlas LoadTextureAtlas(const char **fileNames, int count);
+void UnloadTextureAtlas(TextureAtlas atlas);
+void DrawAtlasSprite(const TextureAtlas *atlas, int sprite, Rectangle dest, Color tint);
+
+#endif
@@ -0,0 +1,281 @@
+#include "include/raylib.h"
+#include "mapObjects.h"
+#include "tilemap.h"
+#include "terrain.h"
+#include "atlas.h"
+#include "stats.h"
+#include "bake.h"
+#define MEM_TAG MEM_BAKE
+#include "memtrack.h"
+
+//----------------------------------------------------------------------------------
+// Module Variables Definition (local)
+//----------------------------------------------------------------------------------
+static RenderTexture2D bakeTarget = { 0 };      // All baked regions share one texture, so they draw in one batch
+static int regionPixels = 0;
+static int slotLevel[BAKE_SLOTS] = { 0 };
+static int slotRegionX[BAKE_SLOTS] = { 0 };
+static int slotRegionY[BAKE_SLOTS] = { 0 };
+static bool slotBaked[BAKE_SLOTS] = { 0 };
+static unsigned int slotLastUsed[BAKE_SLOTS] = { 0 };
+static unsigned int bakeFrame = 0;
+static Texture2D overviewTexture = { 0 };
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition (local)
+//----------------------------------------------------------------------------------
+static int FindSlot(int level, int regionX, int regionY)
+{
+    for (int i = 0; i < BAKE_SLOTS; i++)
+    {
+        if (slotBaked[i] && (slotLevel[i] == level) && (slotRegionX[i] == regionX) && (slotRegionY[i] == regionY)) return i;
+    }
+    return -1;
+}
+
+// Empty slot or the least recently drawn one that isn't needed this frame
+static int AcquireSlot(void)
+{
+    int victim = -1;
+
+    for (int i = 0; i < BAKE_SLOTS; i++)
+    {
+        if (!slotBaked[i]) return i;
+        if ((slotLastUsed[i] != bakeFrame) && ((victim < 0) || (slotLastUsed[i] < slotLastUsed[victim]))) victim = i;
+    }
+
+    return victim;
+}
+
+// Region tiles that lie inside the map
+static void GetRegionTiles(int level, int regionX, int regionY, int *minX, int *minY, int *maxX, int *maxY)
+{
+    int regionTiles = BAKE_REGION_TILES << level;
+
+    *minX = regionX * regionTiles;
+    *minY = regionY * regionTiles;
+    *maxX = MIN(*minX + regionTiles, mapTilesX) - 1;
+    *maxY = MIN(*minY + regionTiles, mapTilesY) - 1;
+}
+
+static bool IsRegionResident(int level, int regionX, int regionY)
+{
+    int minX, minY, maxX, maxY;
+    GetRegionTiles(level, regionX, regionY, &minX, &minY, &maxX, &maxY);
+
+    for (int y = minY; y <= maxY; y++)
+    {
+        for (int x = minX; x <= maxX; x++)
+        {
+            if (!IsTerrainTileResident(x, y)) return false;
+        }
+    }
+    return true;
+}
+
+static void BakeRegion(int slot, int level, int regionX, int regionY, const TextureAtlas *atlas)
+{
+    int minX, minY, maxX, maxY;
+    GetRegionTiles(level, regionX, regionY, &minX, &minY, &maxX, &maxY);
+
+    // Coarser levels squeeze more tiles into the same slot, the sprites get minified while baking. Tiles
+    // land on whole pixels, tileSize >> level wide, so they sample the atlas mipmap of that level texel for texel
+    float tilePixels = (float)regionPixels / (BAKE_REGION_TILES << level);
+    int slotX = (slot % BAKE_ATLAS_REGIONS) * regionPixels;
+    int slotY = (slot / BAKE_ATLAS_REGIONS) * regionPixels;
+
+    for (int y = minY; y <= maxY; y++)
+    {
+        for (int x = minX; x <= maxX; x++)
+        {
+            Rectangle dest = { slotX + (x - minX) * tilePixels, slotY + (y - minY) * tilePixels, tilePixels, tilePixels };
+            DrawAtlasSprite(atlas, GetTerrainTile(x, y), dest, WHITE);
+        }
+    }
+
+    slotLevel[slot] = level;
+    slotRegionX[slot] = regionX;
+    slotRegionY[slot] = regionY;
+    slotBaked[slot] = true;
+}
+
+//----------------------------------------------------------------------------------
+// Terrain Baking Functions Definition
+//----------------------------------------------------------------------------------
+void InitBake(void)
+{
+    if (bakeTarget.id != 0) return;
+
+    regionPixels = BAKE_REGION_TILES * tileSize;
+    bakeTarget = LoadRenderTexture(BAKE_ATLAS_REGIONS * regionPixels, BAKE_ATLAS_REGIONS * regionPixels);
+    SetTextureFilter(bakeTarget.texture, TEXTURE_FILTER_BILINEAR);     // Drawn at up to 2:1 minification
+    InvalidateBakedRegions();
+}
+
+void UnloadBake(void)
+{
+    if (bakeTarget.id == 0) return;
+
+    UnloadRenderTexture(bakeTarget);
+    bakeTarget = (RenderTexture2D){ 0 };
+
+    if (overviewTexture.id != 0) UnloadTexture(overviewTexture);
+    overviewTexture = (Texture2D){ 0 };
+}
+
+void InvalidateBakedRegions(void)
+{
+    for (int i = 0; i < BAKE_SLOTS; i++) slotBaked[i] = false;
+}
+
+int GetBakeLevel(float zoom)
+{
+    int level = 0;
+
+    // Level L holds tileSize >> L texels per tile
+    while ((level < BAKE_LOD_OVERVIEW) && (zoom * 2.0f <= 1.0f / (1 << level))) level++;
+
+    return level;
+}
+
+// Bake the regions covering the tile range that aren't cached yet, a few per frame
+void BakeTerrainRegions(int level, int minX, int minY, int maxX, int maxY, const TextureAtlas *atlas)
+{
+    if ((bakeTarget.id == 0) || (level >= BAKE_LOD_LEVELS)) return;
+
+    int regionTiles = BAKE_REGION_TILES << level;
+    int budget = BAKES_PER_FRAME;
+    bool baking = false;
+    bakeFrame++;
+
+    for (int ry = minY / regionTiles; ry <= maxY / regionTiles; ry++)
+    {
+        for (int rx = minX / regionTiles; rx <= maxX / regionTiles; rx++)
+        {
+            int slot = FindSlot(level, rx, ry);
+
+            // Regions with chunks still streaming in would bake placeholder tiles, wait for them
+            if ((slot < 0) && (budget > 0) && IsRegionResident(level, rx, ry))
+            {
+                slot = AcquireSlot();
+                if (slot < 0) continue;
+
+                if (!baking)
+                {
+                    BeginTextureMode(bakeTarget);
+                    baking = true;
+                }
+
+                BakeRegion(slot, level, rx, ry, atlas);
+                budget--;
+            }
+
+            if (slot >= 0) slotLastUsed[slot] = bakeFrame;
+        }
+    }
+
+    if (baking)
+    {
+        FlushRenderBatch();
+        EndTextureMode();
+    }
+}
+
+// One quad per baked region. Regions that aren't baked yet are drawn tile by tile at level 0,
+// from the overview at coarser levels where that would be thousands of sprites
+void DrawBakedTerrain(int level, int minX, int minY, int maxX, int maxY, const TextureAtlas *atlas)
+{
+    if (level >= BAKE_LOD_LEVELS)
+    {
+        DrawTerrainOverview((Rectangle){ minX * tileSize, minY * tileSize, (maxX - minX + 1) * tileSize, (maxY - minY + 1) * tileSize });
+        return;
+    }
+
+    int regionTiles = BAKE_REGION_TILES << level;
+    float tilePixels = (float)regionPixels / regionTiles;
+
+    for (int ry = minY / regionTiles; ry <= maxY / regionTiles; ry++)
+    {
+        for (int rx = minX / regionTiles; rx <= maxX / regionTiles; rx++)
+        {
+            int tilesMinX, tilesMinY, tilesMaxX, tilesMaxY;
+            GetRegionTiles(level, rx, ry, &tilesMinX, &tilesMinY, &tilesMaxX, &tilesMaxY);
+
+            int slot = (bakeTarget.id != 0) ? FindSlot(level, rx, ry) : -1;
+            if (slot >= 0)
+            {
+                float width = (tilesMaxX - tilesMinX + 1) * tilePixels;
+                float height = (tilesMaxY - tilesMinY + 1) * tilePixels;
+                float slotX = (slot % BAKE_ATLAS_REGIONS) * regionPixels;
+                float slotY = (slot / BAKE_ATLAS_REGIONS) * regionPixels;
+
+                // Render textures are stored bottom-up, flip the source rectangle. Half a texel in from
+                // the edges, so bilinear filtering doesn't pick up the neighbouring slot
+                Rectangle source = { slotX + 0.5f, bakeTarget.texture.height - slotY - height + 0.5f, width - 1.0f, -(height - 1.0f) };
+                Rectangle dest = { tilesMinX * tileSize, tilesMinY * tileSize, (tilesMaxX - tilesMinX + 1) * tileSize, (tilesMaxY - tilesMinY + 1) * tileSize };
+                DrawTexturePro(bakeTarget.texture, source, dest, (Vector2){ 0.0f, 0.0f }, 0.0f, WHITE);
+            }
+            else if ((level > 0) && (overviewTexture.id != 0))
+            {
+                Rectangle region = { tilesMinX * tileSize, tilesMinY * tileSize, (tilesMaxX - tilesMinX + 1) * tileSize, (tilesMaxY - tilesMinY + 1) * tileSize };
+                DrawTerrainOverview(region);
+            }
+            else
+            {
+                for (int y = MAX(tilesMinY, minY); y <= MIN(tilesMaxY, maxY); y++)
+                {
+                    for (int x = MAX(tilesMinX, minX); x <= MIN(tilesMaxX, maxX); x++)
+                    {
+                        DrawAtlasSprite(atlas, GetTerrainTile(x, y), (Rectangle){ x * tileSize, y * tileSize, tileSize, tileSize }, WHITE);
+                    }
+                }
+            }
+        }
+    }
+}
+
+void BakeTerrainOverview(const TileMap *map, const TextureAtlas *atlas)
+{
+    if (overviewTexture.id != 0) UnloadTexture(overviewTexture);
+
+    Image overview = GenImageColor(map->width, map->height, BLANK);
+    Color *pixels = (Color *)overview.data;
+    unsigned char tiles[CHUNK_BYTES];
+
+    for (int cy = 0; cy < map->chunksY; cy++)
+    {
+        for (int cx = 0; cx < map->chunksX; cx++)
+        {
+            ReadTileMapChunk(map, cy * map->chunksX + cx, tiles);
+
+            for (int y = cy * CHUNK_SIZE; y < MIN((cy + 1) * CHUNK_SIZE, map->height); y++)
+            {
+                for (int x = cx * CHUNK_SIZE; x < MIN((cx + 1) * CHUNK_SIZE, map->width); x++)
+                {
+                    pixels[y * map->width + x] = atlas->averages[tiles[GetChunkTileOffset(x & CHUNK_MASK, y & CHUNK_MASK)]];
+                }
+            }
+        }
+    }
+
+    overviewTexture = LoadTextureFromImage(overview);
+    GenTextureMipmaps(&overviewTexture);
+    SetTextureFilter(overviewTexture, TEXTURE_FILTER_TRILINEAR);
+    UnloadImage(overview);
+}
+
+void DrawTerrainOverview(Rectangle area)
+{
+    if (overviewTexture.id == 0) return;
+
+    Rectangle visible = GetCollisionRec(area, (Rectangle){ 0, 0, mapTilesX * tileSize, mapTilesY * tileSize });
+    if ((visible.width <= 0) || (visible.height <= 0)) return;
+
+    Rectangle source = { visible.x / tileSize, visible.y / tileSize, visible.width / tileSize, visible.height / tileSize };
+    DrawTexturePro(overviewTexture, source, visible, (Vector2){ 0.0f, 0.0f }, 0.0f, WHITE);
+}
+
+Texture2D GetTerrainOverview(void)
+{
+    return overviewTexture;
+}
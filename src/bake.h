@@ -0,0 +1,32 @@
+#ifndef BAKE_H
+#define BAKE_H
+//----------------------------------------------------------------------------------
+// Some Defines
+//----------------------------------------------------------------------------------
+#define BAKE_REGION_TILES       2       // Tiles per side of one baked region at level 0
+#ifndef BAKE_ATLAS_REGIONS
+    #define BAKE_ATLAS_REGIONS  4       // Bake target holds BAKE_ATLAS_REGIONS^2 regions (4096x4096 px)
+#endif
+#define BAKE_SLOTS              (BAKE_ATLAS_REGIONS * BAKE_ATLAS_REGIONS)
+#define BAKES_PER_FRAME         2       // Regions still missing are drawn tile by tile meanwhile
+#define BAKE_LOD_LEVELS         5       // Level L bakes (BAKE_REGION_TILES << L) tiles per side into one slot
+#define BAKE_LOD_OVERVIEW       BAKE_LOD_LEVELS     // Farther than the last level: one texel per tile overview
+
+//----------------------------------------------------------------------------------
+// Terrain Baking Functions Declaration
+//----------------------------------------------------------------------------------
+void InitBake(void);
+void UnloadBake(void);
+void InvalidateBakedRegions(void);      // Rebake everything, e.g. after palette textures changed
+int GetBakeLevel(float zoom);           // Coarsest level that still has a texel per screen pixel
+
+// Tile ranges are inclusive. Baking renders to a texture, so it must happen outside BeginMode2D()
+void BakeTerrainRegions(int level, int minX, int minY, int maxX, int maxY, const TextureAtlas *atlas);
+void DrawBakedTerrain(int level, int minX, int minY, int maxX, int maxY, const TextureAtlas *atlas);
+
+// Whole map, one texel per tile colored with the sprite average (reads every chunk of the map)
+void BakeTerrainOverview(const TileMap *map, const TextureAtlas *atlas);
+void DrawTerrainOverview(Rectangle area);   // World area to cover, clipped to the map
+Texture2D GetTerrainOverview(void);
+
+#endif
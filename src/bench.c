@@ -0,0 +1,227 @@
+/*******************************************************************************************
+*
+*   bench - simulation micro-benchmarks
+*
+*   Times the per-tick kernels without opening a window and prints the results as JSON,
+*   so runs can be compared across commits. Built with larger SNAKE_LENGTH and FOOD_ITEMS
+*   (see 'make bench'), body length and fruit count are set at runtime.
+*
+*   Usage: snakebench [output.json]
+*
+********************************************************************************************/
+
+#include "include/raylib.h"
+#include "mapObjects.h"
+#include "tilemap.h"
+#include "arena.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define BENCH_SAMPLES           11
+#define BENCH_MIN_SAMPLE_NS     5000000.0   // Iterations per sample are doubled until one takes this long
+#define BENCH_MAP_TILES         64          // Fruit spawn area, in tiles per side
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+typedef struct Benchmark {
+    const char *name;
+    const char *param;
+    void (*setup)(int value);
+    void (*run)(int iterations);
+    void (*teardown)(void);
+} Benchmark;
+
+//----------------------------------------------------------------------------------
+// Module Variables Definition (local)
+//----------------------------------------------------------------------------------
+static Color *mapColors = NULL;     // Synthetic map image for AssignColors
+static int mapSide = 0;
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition (local)
+//----------------------------------------------------------------------------------
+static double GetBenchTime(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec * 1e9 + now.tv_nsec;
+}
+
+// MoveSnake: shifts every body segment one step
+static void SetupMoveSnake(int length)
+{
+    counterTail = length;
+    for (int i = 0; i < length; i++)
+    {
+        snake[i].position = (Vector2){ 100.0f + i, 100.0f };
+        snake[i].speed = (Vector2){ 3.0f, 3.0f };
+    }
+}
+
+static void RunMoveSnake(int iterations)
+{
+    for (int i = 0; i < iterations; i++) MoveSnake();
+}
+
+// CalcFruitCollision: fruit spawned over the map and in the grid, the head far away so nothing is eaten
+static void SetupFruitCollision(int count)
+{
+    foodCount = count;
+    counterTail = 8;
+    snake->position = (Vector2){ -1e6f, -1e6f };
+    snake->size = 20.0f;
+
+    ResetFruits();
+    CalcFruitPos();
+}
+
+static void RunFruitCollision(int iterations)
+{
+    for (int i = 0; i < iterations; i++) CalcFruitCollision();
+}
+
+// CalcFruitPos: every fruit expired, so one call respawns all of them
+static void SetupFruitSpawn(int count)
+{
+    foodCount = count;
+    counterTail = 8;
+    snake->position = (Vector2){ -1e6f, -1e6f };
+    ResetFruits();
+}
+
+static void RunFruitSpawn(int iterations)
+{
+    for (int i = 0; i < iterations; i++)
+    {
+        for (int f = 0; f < foodCount; f++) fruits[f].lifetime = 0.0f;
+        CalcFruitPos();
+    }
+}
+
+// AssignColors: half the map is one color (uniform chunks), the rest mixes every class
+static void SetupAssignColors(int side)
+{
+    mapSide = side;
+    mapColors = (Color *)RL_MALLOC((size_t)side * side * sizeof(Color));
+
+    for (int y = 0; y < side; y++)
+    {
+        for (int x = 0; x < side; x++)
+        {
+            unsigned char r = (x < side / 2) ? 30 : (unsigned char)((x * 7 + y * 13) & 0xff);
+            mapColors[y * side + x] = (Color){ r, 120, 80, 255 };
+        }
+    }
+}
+
+static void RunAssignColors(int iterations)
+{
+    for (int i = 0; i < iterations; i++) UnloadTileMap(AssignColors(mapColors, mapSide, mapSide));
+}
+
+static void TeardownAssignColors(void)
+{
+    RL_FREE(mapColors);
+    mapColors = NULL;
+}
+
+// Items one call works on, for the throughput figure
+static double GetItemsPerOp(const Benchmark *bench, int value)
+{
+    return (bench->run == RunAssignColors) ? (double)value * value : (double)value;
+}
+
+static void RunBenchmark(FILE *out, const Benchmark *bench, int value)
+{
+    static int written = 0;
+    double samples[BENCH_SAMPLES] = { 0 };
+    int iterations = 1;
+
+    bench->setup(value);
+
+    // Warm up and calibrate
+    while (true)
+    {
+        double start = GetBenchTime();
+        bench->run(iterations);
+        if ((GetBenchTime() - start >= BENCH_MIN_SAMPLE_NS) || (iterations >= (1 << 24))) break;
+        iterations *= 2;
+    }
+
+    double mean = 0.0;
+    double min = INFINITY;
+    for (int s = 0; s < BENCH_SAMPLES; s++)
+    {
+        double start = GetBenchTime();
+        bench->run(iterations);
+        samples[s] = (GetBenchTime() - start) / iterations;
+
+        mean += samples[s] / BENCH_SAMPLES;
+        if (samples[s] < min) min = samples[s];
+    }
+
+    double variance = 0.0;
+    for (int s = 0; s < BENCH_SAMPLES; s++) variance += (samples[s] - mean) * (samples[s] - mean) / (BENCH_SAMPLES - 1);
+
+    if (bench->teardown != NULL) bench->teardown();
+
+    double items = GetItemsPerOp(bench, value);
+    fprintf(out, "%s    {\"name\": \"%s\", \"%s\": %i, \"iterations\": %i, \"samples\": %i, \"ns_per_op\": %.3f, \"min_ns_per_op\": %.3f, "
+            "\"stddev_ns\": %.3f, \"variance_ns2\": %.3f, \"ops_per_sec\": %.1f, \"items_per_sec\": %.1f}",
+            (written++ == 0) ? "" : ",\n", bench->name, bench->param, value, iterations, BENCH_SAMPLES, mean, min,
+            sqrt(variance), variance, 1e9 / mean, items * 1e9 / mean);
+    fflush(out);
+
+    fprintf(stderr, "%-20s %s=%-8i %12.1f ns/op  +-%.1f%%\n", bench->name, bench->param, value, mean, 100.0 * sqrt(variance) / mean);
+}
+
+int main(int argc, char *argv[])
+{
+    static const int lengths[] = { 8, 64, 512, 4096, 65536 };
+    static const int counts[] = { 100, 1000, 10000, 100000, 1000000 };
+    static const int sides[] = { 256, 1024, 4096 };
+
+    const Benchmark moveSnake = { "MoveSnake", "length", SetupMoveSnake, RunMoveSnake, NULL };
+    const Benchmark fruitCollision = { "CalcFruitCollision", "fruits", SetupFruitCollision, RunFruitCollision, NULL };
+    const Benchmark fruitSpawn = { "CalcFruitPos", "fruits", SetupFruitSpawn, RunFruitSpawn, NULL };
+    const Benchmark assignColors = { "AssignColors", "side", SetupAssignColors, RunAssignColors, TeardownAssignColors };
+
+    FILE *out = (argc > 1) ? fopen(argv[1], "w") : stdout;
+    if (out == NULL) return 1;
+
+    SetTraceLogLevel(LOG_WARNING);
+    SetRandomSeed(1);
+
+    mapTilesX = mapTilesY = BENCH_MAP_TILES;
+    mapWidth = mapHeight = BENCH_MAP_TILES * tileSize;
+    InitArenas();
+    InitWorldArena(GetFruitGridSize());
+    InitFruits();
+
+    fprintf(out, "{\n  \"snake_length_max\": %i,\n  \"food_items_max\": %i,\n  \"benchmarks\": [\n", SNAKE_LENGTH, FOOD_ITEMS);
+
+    for (int i = 0; i < (int)(sizeof(lengths) / sizeof(lengths[0])); i++)
+    {
+        if (lengths[i] <= SNAKE_LENGTH) RunBenchmark(out, &moveSnake, lengths[i]);
+    }
+    for (int i = 0; i < (int)(sizeof(counts) / sizeof(counts[0])); i++)
+    {
+        if (counts[i] <= FOOD_ITEMS) RunBenchmark(out, &fruitCollision, counts[i]);
+    }
+    for (int i = 0; i < (int)(sizeof(counts) / sizeof(counts[0])); i++)
+    {
+        if (counts[i] <= FOOD_ITEMS) RunBenchmark(out, &fruitSpawn, counts[i]);
+    }
+    for (int i = 0; i < (int)(sizeof(sides) / sizeof(sides[0])); i++) RunBenchmark(out, &assignColors, sides[i]);
+
+    fprintf(out, "\n  ]\n}\n");
+    if (out != stdout) fclose(out);
+
+    UnloadFruits();
+    UnloadArenas();
+
+    return 0;
+}
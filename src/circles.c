@@ -0,0 +1,143 @@
+#include "include/raylib.h"
+#include "include/raymath.h"
+#include "include/rlgl.h"
+#include "circles.h"
+#include "stats.h"
+#include <stddef.h>
+
+// Instanced drawing needs GL 3.3, the web build (GLES2) always uses the fallback
+#if !defined(PLATFORM_WEB)
+    #define CIRCLES_INSTANCED
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Variables Definition (local)
+//----------------------------------------------------------------------------------
+#if defined(CIRCLES_INSTANCED)
+// Unit quad expanded by radius, the fragment shader cuts the circle out with its distance field
+static const char *circleVertexShader =
+    "#version 330\n"
+    "in vec2 vertexPosition;\n"
+    "in vec3 instanceCircle;\n"         // xy: center, z: radius
+    "in vec4 instanceColor;\n"
+    "uniform mat4 mvp;\n"
+    "out vec2 fragOffset;\n"
+    "out vec4 fragColor;\n"
+    "void main()\n"
+    "{\n"
+    "    fragOffset = vertexPosition;\n"
+    "    fragColor = instanceColor;\n"
+    "    gl_Position = mvp*vec4(instanceCircle.xy + vertexPosition*instanceCircle.z, 0.0, 1.0);\n"
+    "}\n";
+
+static const char *circleFragmentShader =
+    "#version 330\n"
+    "in vec2 fragOffset;\n"
+    "in vec4 fragColor;\n"
+    "out vec4 finalColor;\n"
+    "void main()\n"
+    "{\n"
+    "    float dist = length(fragOffset);\n"
+    "    float edge = fwidth(dist);\n"
+    "    float alpha = 1.0 - smoothstep(1.0 - edge, 1.0, dist);\n"
+    "    if (alpha <= 0.0) discard;\n"
+    "    finalColor = vec4(fragColor.rgb, fragColor.a*alpha);\n"
+    "}\n";
+
+static const float quadVertices[12] = { -1, -1,  1, -1,  1, 1,  -1, -1,  1, 1,  -1, 1 };
+
+static unsigned int circleShader = 0;
+static int mvpLoc = -1;
+static unsigned int circleVao = 0;
+static unsigned int quadVbo = 0;
+static unsigned int instanceVbo = 0;
+#endif
+
+//----------------------------------------------------------------------------------
+// Circle Renderer Functions Definition
+//----------------------------------------------------------------------------------
+void InitCircleRenderer(void)
+{
+#if defined(CIRCLES_INSTANCED)
+    if (rlGetVersion() < OPENGL_33)
+    {
+        TraceLog(LOG_WARNING, "CIRCLES: Instancing not supported, using DrawCircleV()");
+        return;
+    }
+
+    circleShader = rlLoadShaderCode(circleVertexShader, circleFragmentShader);
+    if (circleShader == 0) return;
+
+    mvpLoc = rlGetLocationUniform(circleShader, "mvp");
+    int positionLoc = rlGetLocationAttrib(circleShader, "vertexPosition");
+    int circleLoc = rlGetLocationAttrib(circleShader, "instanceCircle");
+    int colorLoc = rlGetLocationAttrib(circleShader, "instanceColor");
+
+    circleVao = rlLoadVertexArray();
+    rlEnableVertexArray(circleVao);
+
+    quadVbo = rlLoadVertexBuffer(quadVertices, sizeof(quadVertices), false);
+    rlSetVertexAttribute(positionLoc, 2, RL_FLOAT, false, 0, 0);
+    rlEnableVertexAttribute(positionLoc);
+
+    instanceVbo = rlLoadVertexBuffer(NULL, CIRCLE_BATCH_INSTANCES * sizeof(CircleInstance), true);
+    rlSetVertexAttribute(circleLoc, 3, RL_FLOAT, false, sizeof(CircleInstance), (void *)offsetof(CircleInstance, position));
+    rlEnableVertexAttribute(circleLoc);
+    rlSetVertexAttributeDivisor(circleLoc, 1);
+    rlSetVertexAttribute(colorLoc, 4, RL_UNSIGNED_BYTE, true, sizeof(CircleInstance), (void *)offsetof(CircleInstance, color));
+    rlEnableVertexAttribute(colorLoc);
+    rlSetVertexAttributeDivisor(colorLoc, 1);
+
+    rlDisableVertexArray();
+    rlDisableVertexBuffer();
+
+    TraceLog(LOG_INFO, "CIRCLES: Instanced renderer loaded (%i instances per draw)", CIRCLE_BATCH_INSTANCES);
+#endif
+}
+
+void UnloadCircleRenderer(void)
+{
+#if defined(CIRCLES_INSTANCED)
+    if (circleVao != 0)
+    {
+        rlUnloadVertexBuffer(instanceVbo);
+        rlUnloadVertexBuffer(quadVbo);
+        rlUnloadVertexArray(circleVao);
+    }
+    if (circleShader != 0) rlUnloadShaderProgram(circleShader);
+
+    circleShader = 0;
+    circleVao = 0;
+    quadVbo = 0;
+    instanceVbo = 0;
+#endif
+}
+
+void DrawCircleInstances(const CircleInstance *circles, int count)
+{
+#if defined(CIRCLES_INSTANCED)
+    if (circleVao != 0)
+    {
+        // Everything queued before has to reach the screen first to keep draw order
+        FlushRenderBatch();
+
+        rlEnableShader(circleShader);
+        rlSetUniformMatrix(mvpLoc, MatrixMultiply(rlGetMatrixModelview(), rlGetMatrixProjection()));
+        rlEnableVertexArray(circleVao);
+
+        for (int first = 0; first < count; first += CIRCLE_BATCH_INSTANCES)
+        {
+            int instances = ((count - first) < CIRCLE_BATCH_INSTANCES) ? (count - first) : CIRCLE_BATCH_INSTANCES;
+            rlUpdateVertexBuffer(instanceVbo, &circles[first], instances * sizeof(CircleInstance), 0);
+            rlDrawVertexArrayInstanced(0, 6, instances);
+            CountDrawCall(6 * instances);
+        }
+
+        rlDisableVertexArray();
+        rlDisableShader();
+        return;
+    }
+#endif
+
+    for (int i = 0; i < count; i++) DrawCircleV(circles[i].position, circles[i].radius, circles[i].color);
+}
@@ -0,0 +1,25 @@
+#ifndef CIRCLES_H
+#define CIRCLES_H
+//----------------------------------------------------------------------------------
+// Some Defines
+//----------------------------------------------------------------------------------
+#define CIRCLE_BATCH_INSTANCES  4096    // Instances uploaded per draw call
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+// Packed per-instance data, streamed to the GPU as is (16 bytes)
+typedef struct CircleInstance {
+    Vector2 position;
+    float radius;
+    Color color;
+} CircleInstance;
+
+//----------------------------------------------------------------------------------
+// Circle Renderer Functions Declaration
+//----------------------------------------------------------------------------------
+void InitCircleRenderer(void);      // Call after InitWindow(), falls back to DrawCircleV() without instancing
+void UnloadCircleRenderer(void);
+void DrawCircleInstances(const CircleInstance *circles, int count);     // Drawn in array order, last on top
+
+#endif
@@ -0,0 +1,131 @@
+#include "include/raylib.h"
+#include "mapObjects.h"
+#include "tilemap.h"
+#include "terrain.h"
+#include "stats.h"
+#include "pacer.h"
+#include "circles.h"
+#include "sim.h"
+#include "arena.h"
+#include "debug.h"
+#include <stdio.h>
+
+#if defined(DEBUG_OVERLAY)
+//----------------------------------------------------------------------------------
+// Some Defines
+//----------------------------------------------------------------------------------
+#define DEBUG_TILE_CACHE_SIDE   8       // Tile labels are cached direct mapped on (x, y) modulo this
+#define DEBUG_PANEL_LINES       8
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+typedef struct DebugTileLabel {
+    int x;
+    int y;
+    int tile;
+    char coords[24];
+    char label[16];
+    int coordsWidth;
+    int labelWidth;
+} DebugTileLabel;
+
+typedef struct DebugPanelLine {
+    int value;
+    bool valid;
+    char text[48];
+} DebugPanelLine;
+
+//----------------------------------------------------------------------------------
+// Module Variables Definition (local)
+//----------------------------------------------------------------------------------
+static bool overlayVisible = false;
+static DebugTileLabel tileLabels[DEBUG_TILE_CACHE_SIDE * DEBUG_TILE_CACHE_SIDE] = { 0 };
+static DebugPanelLine panelLines[DEBUG_PANEL_LINES] = { 0 };
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition (local)
+//----------------------------------------------------------------------------------
+// Labels are only formatted and measured again when the tile or its class changes
+static const DebugTileLabel *GetTileLabel(int x, int y)
+{
+    DebugTileLabel *entry = &tileLabels[(y % DEBUG_TILE_CACHE_SIDE) * DEBUG_TILE_CACHE_SIDE + (x % DEBUG_TILE_CACHE_SIDE)];
+    int tile = IsTerrainTileResident(x, y) ? GetTerrainTile(x, y) : -1;
+
+    if ((entry->coordsWidth == 0) || (entry->x != x) || (entry->y != y) || (entry->tile != tile))
+    {
+        entry->x = x;
+        entry->y = y;
+        entry->tile = tile;
+        snprintf(entry->coords, sizeof(entry->coords), "[ %d : %d ]", x, y);
+        if (tile >= 0) snprintf(entry->label, sizeof(entry->label), "[tile : %d]", tile);
+        else snprintf(entry->label, sizeof(entry->label), "[tile : ...]");
+        entry->coordsWidth = MeasureText(entry->coords, 46);
+        entry->labelWidth = MeasureText(entry->label, 38);
+    }
+
+    return entry;
+}
+
+static void DrawPanelLine(int line, const char *format, int value, Color color)
+{
+    DebugPanelLine *entry = &panelLines[line];
+
+    if (!entry->valid || (entry->value != value))
+    {
+        snprintf(entry->text, sizeof(entry->text), format, value);
+        entry->value = value;
+        entry->valid = true;
+    }
+
+    DrawText(entry->text, 30, 60 + line * 40, 28, color);
+}
+
+//----------------------------------------------------------------------------------
+// Debug Overlay Functions Definition
+//----------------------------------------------------------------------------------
+void UpdateDebugOverlay(void)
+{
+    if (IsKeyPressed(KEY_F1)) overlayVisible = !overlayVisible;
+}
+
+void DrawDebugOverlayWorld(Camera2D camera)
+{
+    if (!overlayVisible) return;
+
+    Rectangle view = GetCameraWorldRect(camera);
+    int minX = MAX(0, (int)(view.x / tileSize));
+    int minY = MAX(0, (int)(view.y / tileSize));
+    int maxX = MIN(mapTilesX - 1, (int)((view.x + view.width) / tileSize));
+    int maxY = MIN(mapTilesY - 1, (int)((view.y + view.height) / tileSize));
+
+    // Keep within the cache so entries are not thrashed within one frame
+    maxX = MIN(maxX, minX + DEBUG_TILE_CACHE_SIDE - 1);
+    maxY = MIN(maxY, minY + DEBUG_TILE_CACHE_SIDE - 1);
+
+    for (int y = minY; y <= maxY; y++)
+    {
+        for (int x = minX; x <= maxX; x++)
+        {
+            const DebugTileLabel *label = GetTileLabel(x, y);
+            DrawText(label->coords, x * tileSize + tileSize / 2 - label->coordsWidth / 2, y * tileSize + tileSize / 2, 46, BLACK);
+            DrawText(label->label, x * tileSize + tileSize / 2 - label->labelWidth / 2, y * tileSize + tileSize / 1.5, 38, PURPLE);
+        }
+    }
+}
+
+void DrawDebugOverlay(void)
+{
+    if (!overlayVisible) return;
+
+    Vector2 head = GetRenderPacket()->head;
+    DrawPanelLine(0, "tile.x: %d", (int)(head.x / tileSize), DARKPURPLE);
+    DrawPanelLine(1, "tile.y: %d", (int)(head.y / tileSize), DARKPURPLE);
+    DrawPanelLine(2, "Draw calls: %d", GetRenderStats().drawCalls, WHITE);
+    DrawPanelLine(3, "Chunks: %d", GetTerrainResidentChunks(), WHITE);
+    DrawPanelLine(4, "Missed frames: %d", GetFramePacerStats().missedDeadlines, WHITE);
+    DrawPanelLine(5, "Sim arena peak: %d KB", (int)(GetRenderPacket()->simArenaPeak / 1024), WHITE);
+    DrawPanelLine(6, "Frame arena peak: %d KB", (int)(frameArena.highWater / 1024), WHITE);
+    DrawPanelLine(7, "World arena: %d KB", (int)(worldArena.highWater / 1024), WHITE);
+}
+#endif
@@ -0,0 +1,17 @@
+#ifndef DEBUG_H
+#define DEBUG_H
+//----------------------------------------------------------------------------------
+// Debug Overlay Functions Declaration
+//----------------------------------------------------------------------------------
+// Only built with DEBUG_OVERLAY defined (Makefile DEBUG mode), release builds compile the calls out
+#if defined(DEBUG_OVERLAY)
+void UpdateDebugOverlay(void);                  // F1 toggles the overlay
+void DrawDebugOverlayWorld(Camera2D camera);    // Tile labels, call inside BeginMode2D()
+void DrawDebugOverlay(void);                    // Screen space panel
+#else
+    #define UpdateDebugOverlay()
+    #define DrawDebugOverlayWorld(camera)
+    #define DrawDebugOverlay()
+#endif
+
+#endif
@@ -14,7 +14,25 @@
 #include "include/raylib.h"
 #include "include/raymath.h"
 #include "mapObjects.h"
+#include "stats.h"
+#include "circles.h"
+#include "tubes.h"
+#include "debug.h"
+#include "minimap.h"
+#include "atlas.h"
+#include "assets.h"
+#include "watch.h"
+#include "tuning.h"
+#include "profile.h"
+#include "renderbench.h"
+#include "metrics.h"
+#include "pacer.h"
+#include "sim.h"
+#include "arena.h"
+#include "memtrack.h"
 #include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
 
 #if defined(PLATFORM_WEB)
     #include <emscripten/emscripten.h>
@@ -32,37 +50,91 @@ static bool pause = false;
 
 static Camera2D camera = { 0 };
 
+// Handed to the simulation thread, the main thread only writes them while it is idle
+static SimInput simInput = { 0 };
+static int simTicks = 0;
+
+//------------------------------------------------------------------------------------
+// Module Functions Declaration (local)
+//------------------------------------------------------------------------------------
+static void StepSimulation(void);       // Simulation thread
+static void PublishGameState(void);
+
 //------------------------------------------------------------------------------------
 // Program main entry point
 //------------------------------------------------------------------------------------
-int main(void)
+int main(int argc, char *argv[])
 {
     //SetConfigFlags(FLAG_WINDOW_RESIZABLE); // Make the window resizable
     // Initialization (Note windowTitle is unused on Android)
     //---------------------------------------------------------
     InitWindow(screenWidth, screenHeight, "My Snake");
+    SetProfileThreadName("main");
+#if defined(PROFILER)
+    // SNAKE_TRACE=<file.json> records a trace of the whole run
+    if (getenv("SNAKE_TRACE") != NULL) StartProfileTrace(getenv("SNAKE_TRACE"));
+#endif
+    // SNAKE_METRICS_PORT=<port> serves Prometheus metrics on localhost
+    if (getenv("SNAKE_METRICS_PORT") != NULL) InitMetrics(atoi(getenv("SNAKE_METRICS_PORT")));
+    InitArenas();
+    InitRenderStats();
+    InitFileWatch();
+    InitTuning(GetAssetPath("tuning.cfg"));
+    InitAssets();
+    InitCircleRenderer();
+    InitTubeRenderer();
+    InitMap();            // Loaded once, restarting a round only resets simulation state
+    InitSimulation(StepSimulation, SNAKE_LENGTH, FOOD_ITEMS, MINIMAP_MAX_FRUIT_DOTS);
     InitGame();
 
+    // SNAKE_FPS=<fps> sets the render rate, 0 follows the monitor, the simulation stays at 60 ticks
+    InitFramePacer((getenv("SNAKE_FPS") != NULL) ? atoi(getenv("SNAKE_FPS")) : 60, 60);
+
 #if defined(PLATFORM_WEB)
-    emscripten_set_main_loop(UpdateDrawFrame, 60, 1);
+    // requestAnimationFrame timing, the pacer turns it into simulation ticks
+    emscripten_set_main_loop(UpdateDrawFrame, 0, 1);
 #else
-    SetTargetFPS(60);
-    //--------------------------------------------------------------------------------------
-
-    // Main game loop
-    while (!WindowShouldClose())    // Detect window close button or ESC key
+    if ((argc > 1) && (strcmp(argv[1], "--bench-render") == 0))
     {
-        // Update and Draw
-        //----------------------------------------------------------------------------------
-        UpdateDrawFrame();
-        //----------------------------------------------------------------------------------
+        // Scripted camera and snake instead of input, uncapped so frame times are the real cost
+        InitRenderBench((argc > 2) ? argv[2] : "render_bench.json");
+        while (!WindowShouldClose() && UpdateRenderBench(&camera, screenWidth, screenHeight))
+        {
+            ProfileFrame();
+            UpdateAssets();
+            PublishGameState();
+            DrawGame();
+        }
+        UnloadRenderBench();
+    }
+    else
+    {
+        // Main game loop
+        while (!WindowShouldClose())    // Detect window close button or ESC key
+        {
+            // Update and Draw
+            //----------------------------------------------------------------------------------
+            UpdateDrawFrame();
+            //----------------------------------------------------------------------------------
+        }
     }
 #endif
     // De-Initialization
     //--------------------------------------------------------------------------------------
+    StopProfileTrace();
+    UnloadSimulation();
+    UnloadMetrics();
     UnloadGame();         // Unload loaded data (textures, sounds, models...)
+    UnloadAssets();
+    UnloadTuning();
+    UnloadFileWatch();
+    UnloadTubeRenderer();
+    UnloadCircleRenderer();
+    UnloadRenderStats();
+    UnloadArenas();
 
     CloseWindow();        // Close window and OpenGL context
+    ReportMemoryLeaks();  // Everything tagged should be back by now
     //--------------------------------------------------------------------------------------
 
     return 0;
@@ -84,45 +156,56 @@ void InitGame(void)
     camera.rotation = 0.0f;
     camera.zoom = 1.0f;
     InitSnake();
-    InitMap();
+    ResetMap();
+    PublishGameState();
 }
 
 // Update and Draw (one frame)
 void UpdateDrawFrame(void)
 {
-    UpdateGame();
+    int ticks = BeginPacedFrame();
+    ProfileFrame();
+
+    // Simulation state belongs to the main thread until UpdateGame() starts the next step
+    WaitForSimulation();
+    PublishMetrics();
+
+    // Edited tuning values and textures are applied between ticks
+    UpdateFileWatch();
+    UpdateTuning();
+    UpdateAssets();
+
+    PROFILE_BEGIN("UpdateGame");
+    UpdateGame(ticks);
+    PROFILE_END();
+
+    // Draws the newest packet while the simulation works on the next one
     DrawGame();
+    EndPacedFrame();
 }
 
 // Update game (one frame)`LOGIC
-void UpdateGame(void)
+void UpdateGame(int ticks)
 {
     if (!gameOver)
     {
         if (IsKeyPressed('P')) pause = !pause;
+        if (IsKeyPressed('T')) ToggleSnakeTube();
+        UpdateDebugOverlay();
+        UpdateProfileOverlay();
+        UpdateMemoryOverlay();
+        UpdateMinimap();
 
-        if (!pause)
-        {
-            // Player controls
-            UpdateMovement(&camera);
-
-            // Snake movement
-            MoveSnake();
+        // Input snapshot for the simulation thread, a release is kept until a tick has seen it
+        simInput.left = IsKeyDown(KEY_LEFT);
+        simInput.right = IsKeyDown(KEY_RIGHT);
+        simInput.zoomIn = IsKeyDown(KEY_Q);
+        simInput.zoomOut = IsKeyDown(KEY_E);
+        simInput.boost = IsKeyDown(KEY_SPACE);
+        simInput.boostReleased |= IsKeyReleased(KEY_SPACE);
+        simTicks = pause ? 0 : ticks;
 
-            // Wall collision or Collision with self
-            gameOver = CalcWallCollision() || CalcSelfCollision();
-
-            // Fruit position calculation
-            CalcFruitPos();
-
-            // Collision
-            CalcFruitCollision();
-            
-            //Camera updater
-            UpdateCameraCenterInsideMap(&camera, screenWidth, screenHeight);
-
-            framesCounter++;
-        }
+        RunSimulation();
     }
     else
     {
@@ -134,44 +217,154 @@ void UpdateGame(void)
     }
 }
 
+// Fixed steps from the pacer, zero or several when the render rate differs from the tick rate
+static void StepSimulation(void)
+{
+    ResetArena(&simArena);
+
+    for (int tick = 0; (tick < simTicks) && !gameOver; tick++)
+    {
+        BeginMetricsTick();
+
+        // Player controls
+        PROFILE_BEGIN("UpdateMovement");
+        UpdateMovement(&camera, simInput);
+        PROFILE_END();
+
+        // Snake movement
+        PROFILE_BEGIN("MoveSnake");
+        MoveSnake();
+        PROFILE_END();
+
+        // Wall collision or Collision with self
+        gameOver = CalcWallCollision() || CalcSelfCollision();
+
+        // Fruit position calculation
+        PROFILE_BEGIN("CalcFruitPos");
+        CalcFruitPos();
+        PROFILE_END();
+
+        // Collision
+        PROFILE_BEGIN("CalcFruitCollision");
+        CalcFruitCollision();
+        PROFILE_END();
+
+        framesCounter++;
+        EndMetricsTick();
+    }
+    if (simTicks > 0) simInput.boostReleased = false;
+
+    //Camera updater
+    UpdateCameraCenterInsideMap(&camera, screenWidth, screenHeight);
+
+    PublishGameState();
+}
+
+// Copy out what DrawGame() needs, the simulation is free to move on afterwards
+static void PublishGameState(void)
+{
+    PROFILE_BEGIN("PublishGameState");
+    RenderPacket *packet = BeginRenderPacket();
+
+    packet->tick = framesCounter;
+    packet->camera = camera;
+    packet->segmentCount = MIN(counterTail, SNAKE_LENGTH);
+    for (int i = 0; i < packet->segmentCount; i++) packet->segments[i] = (CircleInstance){ snake[i].position, snake[i].size, snake[i].color };
+
+    // Fruit around the view, the margin covers the biggest fruit
+    Vector2 min = GetScreenToWorld2D((Vector2){ 0.0f, 0.0f }, camera);
+    Vector2 max = GetScreenToWorld2D((Vector2){ screenWidth, screenHeight }, camera);
+    Rectangle fruitView = { min.x - 64, min.y - 64, max.x - min.x + 128, max.y - min.y + 128 };
+    size_t mark = GetArenaMark(&simArena);
+    int *visibleFruits = (int *)ArenaAlloc(&simArena, FOOD_ITEMS * sizeof(int));
+    packet->fruitCount = (visibleFruits != NULL) ? QueryFruitsInArea(fruitView, visibleFruits, FOOD_ITEMS) : 0;
+    for (int v = 0; v < packet->fruitCount; v++)
+    {
+        const Food *fruit = &fruits[visibleFruits[v]];
+        packet->fruits[v] = (PacketFruit){ fruit->position, fruit->sprite, fruit->scale };
+    }
+    ResetArenaToMark(&simArena, mark);
+
+    packet->markerCount = 0;
+    for (int i = 0; (i < foodCount) && (packet->markerCount < MINIMAP_MAX_FRUIT_DOTS); i++)
+    {
+        if (fruits[i].active) packet->markers[packet->markerCount++] = fruits[i].position;
+    }
+
+    packet->head = snake->position;
+    packet->headColor = snake->color;
+    packet->score = score;
+    packet->boost = snake->boostCapacity;
+    packet->paused = pause;
+    packet->gameOver = gameOver;
+    packet->simArenaPeak = simArena.highWater;
+
+    PublishRenderPacket();
+    PROFILE_END();
+}
+
 // Draw game (one frame)
 void DrawGame(void)
 {
+    ResetArena(&frameArena);
+
+    // Never NULL, InitGame() publishes the first packet
+    const RenderPacket *packet = AcquireRenderPacket();
+    if (!packet->gameOver) UpdateMapStreaming(packet->camera, packet->head);
+
     BeginDrawing();
+    BeginRenderStatsFrame();
 
         ClearBackground(GRAY);
-        if (!gameOver)
+        if (!packet->gameOver)
         {
-            BeginMode2D(camera);
+            PROFILE_BEGIN("BakeMap");
+            BakeMap(packet->camera);
+            PROFILE_END();
+
+            BeginMode2D(packet->camera);
             //DrawGridUI();
-            DrawMap();
+            // Draw zones time command submission, the GPU work lands in the flushes
+            PROFILE_BEGIN("DrawMap");
+            DrawMap(packet->camera);
+            PROFILE_END();
+            DrawDebugOverlayWorld(packet->camera);
 
             // Draw snake
-            DrawSnake();
-        
+            PROFILE_BEGIN("DrawSnake");
+            DrawSnake(packet->camera);
+            PROFILE_END();
+
+            FlushRenderBatch();
             EndMode2D();
+            DrawMinimap(packet->camera);
             DrawUI();   //UI on top of game elements
+            DrawDebugOverlay();
+            DrawProfileOverlay();
+            DrawMemoryOverlay();
         }
         else DrawText("PRESS [ENTER] TO PLAY AGAIN", GetScreenWidth()/2 - MeasureText("PRESS [ENTER] TO PLAY AGAIN", 20)/2, GetScreenHeight()/2 - 50, 20, RAYWHITE);
 
+    FlushRenderBatch();
+    EndRenderStatsFrame();
     EndDrawing();
 }
 
 // Draws UI textboxes
 void DrawUI(void)
 {
-    if (!pause)
+    const RenderPacket *packet = GetRenderPacket();
+
+    if (!packet->paused)
     DrawText("Press P to pause", screenWidth - MeasureText("Press P to pause", 18) - 20, 20, 18, BLACK);
     else
     {
         DrawText("Press P to continue", screenWidth - MeasureText("Press P to continue", 18) - 20, 20, 18, BLACK);
         DrawText("GAME PAUSED", screenWidth/2 - MeasureText("GAME PAUSED", 40)/2, screenHeight/2 - 40, 40, GRAY);
     }
-    DrawText(TextFormat("SCORE: %02i", score), 30, 40, 24, MAROON);
-    DrawText(TextFormat("BOOST: %.02f", snake->boostCapacity), 600, 40, 24, MAROON);
-    DrawText(TextFormat("TailCount: %d / %d", counterTail, SNAKE_LENGTH), 30, 400, 24, WHITE);
-    DrawText(TextFormat("speed.x: %d", snake->tileXPos), 30, 60, 28, DARKPURPLE);
-    DrawText(TextFormat("speed.y: %d", snake->tileYPos), 30, 100, 28, DARKPURPLE);
+    DrawText(TextFormat("SCORE: %02i", packet->score), 30, 40, 24, MAROON);
+    DrawText(TextFormat("BOOST: %.02f", packet->boost), 600, 40, 24, MAROON);
+    DrawText(TextFormat("TailCount: %d / %d", packet->segmentCount, SNAKE_LENGTH), 30, 400, 24, WHITE);
 }
 
 // Unload game variables
@@ -1,39 +1,81 @@
 #include "include/raylib.h"
+#include "include/raymath.h"
 #include "mapObjects.h"
+#include "tilemap.h"
+#include "terrain.h"
+#include "atlas.h"
+#include "bake.h"
+#include "assets.h"
+#include "tuning.h"
+#include "metrics.h"
+#include "pacer.h"
+#include "circles.h"
+#include "sim.h"
+#include "arena.h"
 #include <stdlib.h>
 #include <sys/types.h>
 
 //----------------------------------------------------------------------------------
 // Module Variables Definition (global)
 //----------------------------------------------------------------------------------
-static const u_int mapSize = 500;
 const float tileSize = 512.0f;
-const int mapWidth = mapSize * tileSize;
-const int mapHeight = mapSize * tileSize;
+int mapWidth = 0;      // Set from the loaded tile map
+int mapHeight = 0;
+int mapTilesX = 0;
+int mapTilesY = 0;
 int borderWidth = 40;
 int offMapSize = 110; //how many pixels to fit outside the map in the screen when near borders
 
 Food fruits[FOOD_ITEMS] = { 0 };
+int foodCount = FOOD_ITEMS;
 
 //----------------------------------------------------------------------------------
 // Module Variables Definition (local)
 //----------------------------------------------------------------------------------
-static Texture2D texPalette[7] = { 0 };
-static Color* colors = { 0 };
+static TextureAtlas mapAtlas = { 0 };      // Terrain palette and fruit sprites packed in one texture
+// Background and walls repeat over huge areas, they keep their own wrapping textures
 static Texture2D bgTexture = { 0 };
 static Texture2D wallTexture = { 0 };
-static Texture2D raspberryTexture = { 0 };
-static Texture2D pineapleTexture = { 0 };
-static Texture2D sushiTexture = { 0 };
-static Texture2D pizzaTexture = { 0 };
+static Vector2 bgRepeatSize = { 0 };       // World size of one texture repeat
+static Vector2 wallRepeatSize = { 0 };
+static int atlasAsset = -1;                // Loaded in the background, placeholders are drawn meanwhile
+static int bgAsset = -1;
+static int wallAsset = -1;
+static unsigned int atlasVersion = 0;      // Asset version in use, 0 while on the placeholder
+static unsigned int bgVersion = 0;
+static unsigned int wallVersion = 0;
+static float bgParallax = 0.75f;           // 1.0 keeps the background fixed to the world
+static const char *spriteFiles[SPRITE_COUNT] = {
+    [WATER] = "textures/03_Water.png",
+    [SAND] = "textures/23_Sand.png",
+    [ROCK] = "textures/04_Ground.png",
+    [DIRT] = "textures/10_Dirt.png",
+    [GRASS1] = "textures/15_Grass.png",
+    [GRASS2] = "textures/18_Grass.png",
+    [GRASS3] = "textures/20_Grass.png",
+    [SPRITE_RASPBERRY] = "items/raspberry64.png",
+    [SPRITE_PINEAPLE] = "items/pineaple64.png",
+    [SPRITE_SUSHI] = "items/sushi64.png",
+    [SPRITE_PIZZA] = "items/pizza64.png",
+};
 
 
 //Map dimensions
-static unsigned char** tileMapCoordinates = { 0 };
-static unsigned short xPreLoadTile = 2;     // how many tiles to render in each axis from player
-static unsigned short yPreLoadTile = 2;
+static TileMap tileMap = { 0 };        // Precompiled .tmap (see 'make tmap') or BWMap.png classified at startup
+static unsigned short preLoadTiles = 1;     // how many tiles to render around the view
 static int theExtra = 0;    // extra space needed for drawing bg and fg
 
+#define MAX_ZOOM 4.0f
+
+//Fruit spatial index: uniform grid, every cell holds a doubly linked list of fruit indices
+#define FRUIT_CELL_SIZE 1024
+static int* fruitCellHead = NULL;
+static int fruitGridX = 0;
+static int fruitGridY = 0;
+static int fruitCell[FOOD_ITEMS] = { 0 };
+static int fruitNext[FOOD_ITEMS] = { 0 };
+static int fruitPrev[FOOD_ITEMS] = { 0 };
+
 //Map objects
 static float minusFoodLifetime = 8.0f;
 static float bonusFoodLifetime = 10.0f;
@@ -50,46 +92,195 @@ static int regularFruitTailIncrease = 1;
 //----------------------------------------------------------------------------------
 // Map related Functions Definition
 //----------------------------------------------------------------------------------
+// Take over assets that finished loading or were reloaded since the last frame
+static void SwapInMapAssets(void)
+{
+    if (atlasVersion != GetAssetVersion(atlasAsset))
+    {
+        mapAtlas = GetAssetAtlas(atlasAsset);
+        SetShapesTexture(mapAtlas.texture, mapAtlas.white);
+
+        // Anything baked so far used the placeholder
+        InvalidateBakedRegions();
+        BakeTerrainOverview(&tileMap, &mapAtlas);
+        atlasVersion = GetAssetVersion(atlasAsset);
+    }
+
+    if (bgVersion != GetAssetVersion(bgAsset))
+    {
+        bgTexture = GetAssetTexture(bgAsset);
+        bgRepeatSize = GetAssetSourceSize(bgAsset);
+        bgVersion = GetAssetVersion(bgAsset);
+    }
+
+    if (wallVersion != GetAssetVersion(wallAsset))
+    {
+        wallTexture = GetAssetTexture(wallAsset);
+        wallRepeatSize = Vector2Scale(GetAssetSourceSize(wallAsset), 0.5f);
+        wallVersion = GetAssetVersion(wallAsset);
+    }
+}
+
+// Draw the part of area inside view as a single quad, the texture repeats through its UVs
+static void DrawTextureRepeated(Texture2D texture, Vector2 repeatSize, Rectangle area, Rectangle view, float parallax)
+{
+    Rectangle visible = GetCollisionRec(area, view);
+    if ((visible.width <= 0) || (visible.height <= 0)) return;
+
+    float texelsX = texture.width / repeatSize.x;
+    float texelsY = texture.height / repeatSize.y;
+    Vector2 offset = { visible.x - area.x - (view.x - area.x) * (1.0f - parallax), visible.y - area.y - (view.y - area.y) * (1.0f - parallax) };
+    Rectangle source = { offset.x * texelsX, offset.y * texelsY, visible.width * texelsX, visible.height * texelsY };
+
+    DrawTexturePro(texture, source, visible, (Vector2){ 0.0f, 0.0f }, 0.0f, WHITE);
+}
+
+// Move fruit to the grid cell of its current position
+static void UpdateFruitCell(int i)
+{
+    if (fruitCellHead == NULL) return;
+
+    int cellX = Clamp(fruits[i].position.x / FRUIT_CELL_SIZE, 0, fruitGridX - 1);
+    int cellY = Clamp(fruits[i].position.y / FRUIT_CELL_SIZE, 0, fruitGridY - 1);
+    int cell = cellY * fruitGridX + cellX;
+
+    if (cell == fruitCell[i]) return;
+
+    if (fruitCell[i] >= 0)
+    {
+        if (fruitPrev[i] >= 0) fruitNext[fruitPrev[i]] = fruitNext[i];
+        else fruitCellHead[fruitCell[i]] = fruitNext[i];
+        if (fruitNext[i] >= 0) fruitPrev[fruitNext[i]] = fruitPrev[i];
+    }
+
+    fruitPrev[i] = -1;
+    fruitNext[i] = fruitCellHead[cell];
+    if (fruitCellHead[cell] >= 0) fruitPrev[fruitCellHead[cell]] = i;
+    fruitCellHead[cell] = i;
+    fruitCell[i] = cell;
+}
+
+// Load everything the map needs once, rounds only go through ResetMap()
 void InitMap(void)
 {
-    for (u_short i = 0; i < FOOD_ITEMS; i++) fruits[i].active = false;
+    tileMap = LoadTileMap(GetAssetPath("textures/BWMap.tmap"));
+    if (tileMap.data == NULL)
+    {
+        // No usable precompiled map, decode and classify the PNG (pixels are freed right after)
+        TraceLog(LOG_WARNING, "MAP: BWMap.tmap not found or outdated, decoding BWMap.png (run 'make tmap')");
+
+        Image mapImage = LoadImage(GetAssetPath("textures/BWMap.png"));
+        Color* colors = LoadImageColors(mapImage);
+        tileMap = AssignColors(colors, mapImage.width, mapImage.height);
+        UnloadImageColors(colors);
+        UnloadImage(mapImage);
+    }
 
-    colors = LoadImageColors(LoadImage("../resources/textures/BWMap.png"));
-    tileMapCoordinates = AssignColors(colors);
+    mapTilesX = tileMap.width;
+    mapTilesY = tileMap.height;
+    mapWidth = mapTilesX * tileSize;
+    mapHeight = mapTilesY * tileSize;
+    InitWorldArena(GetFruitGridSize());
 
-    texPalette[WATER] = LoadTexture("../resources/textures/03_Water.png");
-    texPalette[SAND] = LoadTexture("../resources/textures/23_Sand.png");
-    texPalette[ROCK] = LoadTexture("../resources/textures/04_Ground.png");
-    texPalette[DIRT] = LoadTexture("../resources/textures/10_Dirt.png");
-    texPalette[GRASS1] = LoadTexture("../resources/textures/15_Grass.png");
-    texPalette[GRASS2] = LoadTexture("../resources/textures/18_Grass.png");
-    texPalette[GRASS3] = LoadTexture("../resources/textures/20_Grass.png");
+    // Only chunks around the player are kept resident
+    InitTerrain(&tileMap);
 
-    bgTexture = LoadTexture("../resources/textures/04Dirt1920x1080.png");
-    wallTexture = LoadTexture("../resources//textures/stone480.png");
-    
-    raspberryTexture = LoadTexture("../resources/items/raspberry64.png");
-    pineapleTexture = LoadTexture("../resources/items/pineaple64.png");
-    sushiTexture = LoadTexture("../resources/items/sushi64.png");
-    pizzaTexture = LoadTexture("../resources/items/pizza64.png");
+    // Fruit balancing, changes apply to fruit spawned afterwards
+    TuneFloat("minusFoodLifetime", &minusFoodLifetime);
+    TuneFloat("bonusFoodLifetime", &bonusFoodLifetime);
+    TuneFloat("regularFoodLifetime", &regularFoodLifetime);
+    TuneInt("minusFruitPoints", &minusFruitPoints);
+    TuneInt("bonusFruitPoints", &bonusFruitPoints);
+    TuneInt("regularFruitPoints", &regularFruitPoints);
+    TuneFloat("minusFruitScale", &minusFruitScale);
+    TuneFloat("bonusFruitScale", &bonusFruitScale);
+    TuneFloat("regularFruitScale", &regularFruitScale);
+    TuneInt("bonusFruitTailIncrease", &bonusFruitTailIncrease);
+    TuneInt("regularFruitTailIncrease", &regularFruitTailIncrease);
+    TuneFloat("bgParallax", &bgParallax);
+
+    // Textures decode in the background, the first frames draw placeholders
+    atlasAsset = RequestAtlas("atlas/map", spriteFiles, SPRITE_COUNT);
+    bgAsset = RequestTexture("textures/04Dirt1920x1080.png", ASSET_REPEAT);
+    wallAsset = RequestTexture("textures/stone480.png", ASSET_REPEAT);
+
+    mapAtlas = GetAssetAtlas(atlasAsset);
+    bgTexture = GetAssetTexture(bgAsset);
+    wallTexture = GetAssetTexture(wallAsset);
+    bgRepeatSize = wallRepeatSize = (Vector2){ 1.0f, 1.0f };
+    atlasVersion = bgVersion = wallVersion = 0;
+
+    // Shapes (snake body, fruit outlines) sample the atlas too, so they don't break the batch
+    SetShapesTexture(mapAtlas.texture, mapAtlas.white);
+
+    InitBake();
+    InvalidateBakedRegions();
+
+    InitFruits();
 
     theExtra = borderWidth * 2 + offMapSize * 2;
 }
 
+// Start a new round: clear fruit and have the spawn area resident for the first frame
+void ResetMap(void)
+{
+    ResetFruits();
+
+    Vector2 spawnTile = { snake->position.x / tileSize, snake->position.y / tileSize };
+    UpdateTerrainStreaming(&spawnTile, 1, CHUNK_SIZE);
+    FlushTerrainStreaming();
+}
+
+// Bytes of world arena the fruit grid takes for the current map dimensions
+int GetFruitGridSize(void)
+{
+    return (mapWidth / FRUIT_CELL_SIZE + 1) * (mapHeight / FRUIT_CELL_SIZE + 1) * (int)sizeof(int);
+}
+
+void InitFruits(void)
+{
+    fruitGridX = mapWidth / FRUIT_CELL_SIZE + 1;
+    fruitGridY = mapHeight / FRUIT_CELL_SIZE + 1;
+    fruitCellHead = (int *)ArenaAlloc(&worldArena, GetFruitGridSize());
+    if (fruitCellHead == NULL)
+    {
+        TraceLog(LOG_ERROR, "MAP: No memory for the %ix%i fruit grid, fruit disabled", fruitGridX, fruitGridY);
+        fruitGridX = fruitGridY = 0;
+    }
+    ResetFruits();
+}
+
+void ResetFruits(void)
+{
+    if (foodCount > FOOD_ITEMS) foodCount = FOOD_ITEMS;
+    if (fruitCellHead == NULL) foodCount = 0;
+
+    for (int i = 0; i < FOOD_ITEMS; i++) fruits[i].active = false;
+    for (int i = 0; i < fruitGridX * fruitGridY; i++) fruitCellHead[i] = -1;
+    for (int i = 0; i < FOOD_ITEMS; i++) fruitCell[i] = -1;
+}
+
+// The grid itself goes back with the world arena
+void UnloadFruits(void)
+{
+    fruitCellHead = NULL;
+}
+
 void CalcFruitPos(void)
 {
-    for (u_short i = 0; i < FOOD_ITEMS; i++)
+    for (int i = 0; i < foodCount; i++)
     {
         if (fruits[i].lifetime <= 0) fruits[i].active = false;
         if (!fruits[i].active)
         {
             fruits[i].active = true;
+            CountMetric(METRIC_FRUIT_SPAWNS);
             int randomValue = GetRandomValue(1, 40);
             //MinusFruit
             if (randomValue % 20 == 0)
             {
                 fruits[i].scale = minusFruitScale;
-                fruits[i].foodTexture = &pizzaTexture;
+                fruits[i].sprite = SPRITE_PIZZA;
                 fruits[i].foodType = TAILCUT;
                 fruits[i].position = (Vector2){ GetRandomValue(64, mapWidth - 64), GetRandomValue(64, (mapHeight - 64) - 2)};
                 fruits[i].points = minusFruitPoints;
@@ -100,7 +291,7 @@ void CalcFruitPos(void)
             else if (randomValue % 10 == 0) 
             {
                 fruits[i].scale = .5f;
-                fruits[i].foodTexture = &sushiTexture;
+                fruits[i].sprite = SPRITE_SUSHI;
                 fruits[i].foodType = BOOST;
                 fruits[i].position = (Vector2){ GetRandomValue(64, mapWidth - 64), GetRandomValue(64, (mapHeight - 64) - 2)};
                 fruits[i].points = bonusFruitPoints;
@@ -112,7 +303,7 @@ void CalcFruitPos(void)
             {
                 fruits[i].scale = bonusFruitScale;
                 fruits[i].foodType = BOOST;
-                fruits[i].foodTexture = &pineapleTexture;
+                fruits[i].sprite = SPRITE_PINEAPLE;
                 fruits[i].position = (Vector2){ GetRandomValue(64, mapWidth - 64), GetRandomValue(64, (mapHeight - 64) - 2)};
                 fruits[i].points = bonusFruitPoints;
                 fruits[i].tailIncreaseSize = bonusFruitTailIncrease;
@@ -122,7 +313,7 @@ void CalcFruitPos(void)
             else
             {
                 fruits[i].scale = regularFruitScale;
-                fruits[i].foodTexture = &raspberryTexture;
+                fruits[i].sprite = SPRITE_RASPBERRY;
                 fruits[i].foodType = REGULAR;
                 fruits[i].position = (Vector2){ GetRandomValue(64, mapWidth - 64), GetRandomValue(64, (mapHeight - 64) - 2)};
                 fruits[i].points = regularFruitPoints;
@@ -132,43 +323,102 @@ void CalcFruitPos(void)
             
             if (FruitIsOnSnake(fruits[i]))
             fruits[i].position = (Vector2){ GetRandomValue(64, mapWidth - 64), GetRandomValue(64, (mapHeight - 64) - 2)};
-            
+
+            UpdateFruitCell(i);
         }
-        fruits[i].lifetime -= GetFrameTime();
+        fruits[i].lifetime -= GetTickTime();
     }
 }
 
-void DrawMap(void)
+// Tiles visible through the camera, inclusive and clamped to the map
+static void GetDrawnTileRange(Camera2D camera, int *minX, int *minY, int *maxX, int *maxY)
 {
-    // BG and FG
-    if (snake->tileXPos <= 1 || snake->tileXPos >= mapSize - 2 || snake->tileYPos <= 1 || snake->tileYPos >= mapSize - 2)
-    DrawTextureTiled(bgTexture, (Rectangle){0.0f, 0.0f, 1920.0f, 1280.0f}, (Rectangle){-offMapSize - borderWidth, -offMapSize - borderWidth, mapWidth + theExtra, mapHeight + theExtra}, (Vector2){0.0f, 0.0f}, 0.0f, 1.0f, WHITE);
+    Rectangle view = GetCameraWorldRect(camera);
 
-    //Clamp iterators to 0 or MAP
-    for (u_short i = MAX((snake->tileYPos - yPreLoadTile), 0); i < MIN((snake->tileYPos + yPreLoadTile + 1), mapSize); i++)
+    *minX = MAX((int)floorf(view.x / tileSize) - preLoadTiles, 0);
+    *minY = MAX((int)floorf(view.y / tileSize) - preLoadTiles, 0);
+    *maxX = MIN((int)floorf((view.x + view.width) / tileSize) + preLoadTiles, mapTilesX - 1);
+    *maxY = MIN((int)floorf((view.y + view.height) / tileSize) + preLoadTiles, mapTilesY - 1);
+}
+
+// Bake terrain regions that scrolled into view, must be called before BeginMode2D()
+void BakeMap(Camera2D camera)
+{
+    SwapInMapAssets();
+    if (atlasVersion == 0) return;
+
+    int minX, minY, maxX, maxY;
+    GetDrawnTileRange(camera, &minX, &minY, &maxX, &maxY);
+    BakeTerrainRegions(GetBakeLevel(camera.zoom), minX, minY, maxX, maxY, &mapAtlas);
+}
+
+// Fill indices with the active fruits whose grid cells overlap area, returns how many were found
+int QueryFruitsInArea(Rectangle area, int *indices, int maxCount)
+{
+    int count = 0;
+    if (fruitCellHead == NULL) return 0;
+
+    int minX = Clamp(area.x / FRUIT_CELL_SIZE, 0, fruitGridX - 1);
+    int minY = Clamp(area.y / FRUIT_CELL_SIZE, 0, fruitGridY - 1);
+    int maxX = Clamp((area.x + area.width) / FRUIT_CELL_SIZE, 0, fruitGridX - 1);
+    int maxY = Clamp((area.y + area.height) / FRUIT_CELL_SIZE, 0, fruitGridY - 1);
+
+    for (int y = minY; y <= maxY; y++)
     {
-        for (u_short j = MAX((snake->tileXPos - xPreLoadTile), 0); j < MIN((snake->tileXPos + xPreLoadTile + 1), mapSize); j++)
+        for (int x = minX; x <= maxX; x++)
         {
-            DrawTexture(texPalette[tileMapCoordinates[i][j]], j * tileSize, i * tileSize, WHITE);
-            DrawText(TextFormat("[ %d : %d ]", j, i), j * tileSize + tileSize / 2 - (float)MeasureText(TextFormat("[ %d : %d ]", j, i), 46) / 2, i * tileSize + tileSize / 2, 46, BLACK);
-            DrawText(TextFormat("[%d : %d : %d]", colors[i * mapSize + j].r, colors[i * mapSize + j].g, colors[i * mapSize + j].b),
-                    j * tileSize + tileSize / 2 - (float)MeasureText(TextFormat("[%d : %d : %d]", colors[i * mapSize + j].r, colors[i * mapSize + j].g, colors[i * mapSize + j].b), 38) / 2,
-                    i * tileSize + tileSize / 1.5,
-                    38, PURPLE);
+            for (int i = fruitCellHead[y * fruitGridX + x]; (i >= 0) && (count < maxCount); i = fruitNext[i])
+            {
+                if (fruits[i].active) indices[count++] = i;
+            }
         }
     }
 
+    return count;
+}
+
+// World space rectangle visible through the camera
+Rectangle GetCameraWorldRect(Camera2D camera)
+{
+    Vector2 min = GetScreenToWorld2D((Vector2){ 0.0f, 0.0f }, camera);
+    Vector2 max = GetScreenToWorld2D((Vector2){ GetScreenWidth(), GetScreenHeight() }, camera);
+
+    return (Rectangle){ min.x, min.y, max.x - min.x, max.y - min.y };
+}
+
+void DrawMap(Camera2D camera)
+{
+    Rectangle view = GetCameraWorldRect(camera);
+
+    // BG and FG, only needed once the view reaches past the map
+    if ((view.x < 0) || (view.y < 0) || (view.x + view.width > mapWidth) || (view.y + view.height > mapHeight))
+    DrawTextureRepeated(bgTexture, bgRepeatSize, (Rectangle){-offMapSize - borderWidth, -offMapSize - borderWidth, mapWidth + theExtra, mapHeight + theExtra}, view, bgParallax);
+
+    // Coarser bakes when zoomed out keep the number of regions on screen about the same
+    int minX, minY, maxX, maxY;
+    GetDrawnTileRange(camera, &minX, &minY, &maxX, &maxY);
+    DrawBakedTerrain(GetBakeLevel(camera.zoom), minX, minY, maxX, maxY, &mapAtlas);
+
     // Borders
-    DrawTextureTiled(wallTexture, (Rectangle){0.0f, 0.0f, 480.0f, 480.0f}, (Rectangle){-borderWidth, -borderWidth, mapWidth + borderWidth, borderWidth}, (Vector2){0.0f, 0.0f}, 0.0f, .5f, WHITE);
-    DrawTextureTiled(wallTexture, (Rectangle){0.0f, 0.0f, 480.0f, 480.0f}, (Rectangle){-borderWidth, 0, borderWidth, mapHeight}, (Vector2){0.0f, 0.0f}, 0.0f, .5f, WHITE);
-    DrawTextureTiled(wallTexture, (Rectangle){0.0f, 0.0f, 480.0f, 480.0f}, (Rectangle){-borderWidth, mapHeight, mapWidth + borderWidth, borderWidth}, (Vector2){0.0f, 0.0f}, 0.0f, .5f, WHITE);
-    DrawTextureTiled(wallTexture, (Rectangle){0.0f, 0.0f, 480.0f, 480.0f}, (Rectangle){mapWidth, -borderWidth, borderWidth, mapHeight + borderWidth * 2}, (Vector2){0.0f, 0.0f}, 0.0f, .5f, WHITE);
-    
-    // Draw fruit to pick
-    for (u_short i = 0; i < FOOD_ITEMS; i++)
+    DrawTextureRepeated(wallTexture, wallRepeatSize, (Rectangle){-borderWidth, -borderWidth, mapWidth + borderWidth, borderWidth}, view, 1.0f);
+    DrawTextureRepeated(wallTexture, wallRepeatSize, (Rectangle){-borderWidth, 0, borderWidth, mapHeight}, view, 1.0f);
+    DrawTextureRepeated(wallTexture, wallRepeatSize, (Rectangle){-borderWidth, mapHeight, mapWidth + borderWidth, borderWidth}, view, 1.0f);
+    DrawTextureRepeated(wallTexture, wallRepeatSize, (Rectangle){mapWidth, -borderWidth, borderWidth, mapHeight + borderWidth * 2}, view, 1.0f);
+
+    // Fruit to pick, the packet only holds the ones around the visible area
+    const RenderPacket *packet = GetRenderPacket();
+
+    // Sprites first and outlines after so each group stays one draw call
+    for (int v = 0; v < packet->fruitCount; v++)
     {
-        DrawTextureEx(*fruits[i].foodTexture, (Vector2){fruits[i].position.x - 32 * fruits[i].scale, fruits[i].position.y - 32 * fruits[i].scale}, 0, fruits[i].scale, WHITE);
-        DrawCircleLines(fruits[i].position.x, fruits[i].position.y, 32 * fruits[i].scale, RED);
+        const PacketFruit *fruit = &packet->fruits[v];
+        Rectangle sprite = mapAtlas.sprites[fruit->sprite];
+        DrawAtlasSprite(&mapAtlas, fruit->sprite, (Rectangle){fruit->position.x - 32 * fruit->scale, fruit->position.y - 32 * fruit->scale, sprite.width * fruit->scale, sprite.height * fruit->scale}, WHITE);
+    }
+    for (int v = 0; v < packet->fruitCount; v++)
+    {
+        const PacketFruit *fruit = &packet->fruits[v];
+        DrawCircleLines(fruit->position.x, fruit->position.y, 32 * fruit->scale, RED);
     }
 }
 
@@ -189,42 +439,57 @@ void UpdateCameraCenterInsideMap(Camera2D *camera, int screenWidth, int screenHe
     if (min.x > 0) camera->offset.x = screenWidth/2.0f - min.x;
     if (min.y > 0) camera->offset.y = screenHeight/2.0f - min.y;
 
-    if (camera->zoom > 1.4f) camera->zoom = 1.4f;
-    if (camera->zoom < .7f) camera->zoom = .7f;
+    // Terrain has levels of detail, zoom out until the whole map fits the screen
+    float fitZoom = MIN(screenWidth / (maxX - minX), screenHeight / (maxY - minY));
+    if (camera->zoom > MAX_ZOOM) camera->zoom = MAX_ZOOM;
+    if (camera->zoom < fitZoom) camera->zoom = fitZoom;
+
+    // Center the axes where the map is smaller than the screen
+    if ((maxX - minX) * camera->zoom <= screenWidth)
+    {
+        camera->target.x = (minX + maxX) / 2.0f;
+        camera->offset.x = screenWidth / 2.0f;
+    }
+    if ((maxY - minY) * camera->zoom <= screenHeight)
+    {
+        camera->target.y = (minY + maxY) / 2.0f;
+        camera->offset.y = screenHeight / 2.0f;
+    }
 }
 
-unsigned char** AssignColors(Color* colors)
+// Keep the terrain chunks around the view and the snake head resident
+void UpdateMapStreaming(Camera2D camera, Vector2 head)
 {
-    unsigned char** collArray = (unsigned char**) RL_MALLOC(mapSize * sizeof(unsigned char*));
-    for (u_short i = 0; i < mapSize; i++) collArray[i] = (unsigned char*) RL_MALLOC(mapSize * sizeof(unsigned char));
+    Vector2 viewCenter = GetScreenToWorld2D((Vector2){ GetScreenWidth()/2.0f, GetScreenHeight()/2.0f }, camera);
+    Vector2 focus[2] = {
+        { viewCenter.x / tileSize, viewCenter.y / tileSize },
+        { head.x / tileSize, head.y / tileSize }
+    };
 
-    for (u_short y = 0; y < mapSize; y++)
+    // Drawn from the overview, only the area around the snake needs tiles
+    if (GetBakeLevel(camera.zoom) >= BAKE_LOD_LEVELS)
     {
-        for (u_short x = 0; x < mapSize; x++)
-        {
-            if (colors[y * mapSize + x].b >= 220 &&
-                colors[y * mapSize + x].r <= 220 &&
-                colors[y * mapSize + x].g <= 220) collArray[y][x] = WATER;
-
-            if (colors[y * mapSize + x].r <= 10) collArray[y][x] = SAND;
-            else if (colors[y * mapSize + x].r <= 50) collArray[y][x] = DIRT;
-            else if (colors[y * mapSize + x].r <= 90) collArray[y][x] = GRASS1;
-            else if (colors[y * mapSize + x].r <= 130) collArray[y][x] = GRASS2;
-            else if (colors[y * mapSize + x].r <= 170) collArray[y][x] = GRASS3;
-            else collArray[y][x] = ROCK;
-        }
+        UpdateTerrainStreaming(&focus[1], 1, CHUNK_SIZE);
+        return;
     }
-    return collArray;
+
+    // Half diagonal of the visible area plus one chunk of look-ahead
+    float viewRadius = Vector2Length((Vector2){ GetScreenWidth(), GetScreenHeight() }) / 2.0f / camera.zoom / tileSize;
+
+    UpdateTerrainStreaming(focus, 2, viewRadius + CHUNK_SIZE);
 }
 
 void UnloadMap(void)
 {
-    UnloadTexture(bgTexture);
-    for (u_short i = 0; i < 6; i++) UnloadTexture(texPalette[i]);
-    UnloadTexture(wallTexture);
-    UnloadTexture(raspberryTexture);
-    UnloadTexture(pineapleTexture);
-    UnloadTexture(sushiTexture);
-    UnloadTexture(pizzaTexture);
-    RL_FREE(tileMapCoordinates);
+    UnloadAsset(atlasAsset);
+    UnloadAsset(bgAsset);
+    UnloadAsset(wallAsset);
+    atlasAsset = bgAsset = wallAsset = -1;
+    atlasVersion = bgVersion = wallVersion = 0;
+    UnloadFruits();
+    UnloadBake();
+    UnloadTerrain();
+    UnloadTileMap(tileMap);
+    tileMap = (TileMap){ 0 };
+    UnloadArena(&worldArena);
 }
@@ -3,8 +3,12 @@
 //----------------------------------------------------------------------------------
 // Some Defines
 //----------------------------------------------------------------------------------
-#define SNAKE_LENGTH   512
-#define FOOD_ITEMS      100
+#ifndef SNAKE_LENGTH
+    #define SNAKE_LENGTH    512     // Longest possible tail (the bench build raises these)
+#endif
+#ifndef FOOD_ITEMS
+    #define FOOD_ITEMS      100     // Fruit slots, foodCount of them are in play
+#endif
 
 #define MIN(x, y) (((x) < (y)) ? (x) : (y))
 #define MAX(x, y) (((x) > (y)) ? (x) : (y))
@@ -13,12 +17,14 @@
 //----------------------------------------------------------------------------------
 typedef enum FoodType { REGULAR, BONUS, BOOST, TAILCUT } FoodType;
 enum paletteName {WATER, SAND, ROCK, DIRT, GRASS1, GRASS2, GRASS3};
+// Map atlas sprites, terrain sprites share their index with paletteName
+enum spriteName {SPRITE_RASPBERRY = GRASS3 + 1, SPRITE_PINEAPLE, SPRITE_SUSHI, SPRITE_PIZZA, SPRITE_COUNT};
 
 
 typedef struct Snake {
     Vector2 position;
-    unsigned short tileXPos;
-    unsigned short tileYPos;;
+    int tileXPos;
+    int tileYPos;
     float boostCapacity;
     float size;
     Vector2 speed;
@@ -27,7 +33,7 @@ typedef struct Snake {
 
 typedef struct Food {
     Vector2 position;
-    Texture2D* foodTexture;
+    int sprite;
     float scale;
     int foodType;
     bool active;
@@ -36,6 +42,16 @@ typedef struct Food {
     float lifetime;
 } Food;
 
+// Keys the simulation reads, snapshotted on the main thread once per frame
+typedef struct SimInput {
+    bool left;
+    bool right;
+    bool zoomIn;
+    bool zoomOut;
+    bool boost;
+    bool boostReleased;
+} SimInput;
+
 //----------------------------------------------------------------------------------
 // Global Variables Definition
 //----------------------------------------------------------------------------------
@@ -43,11 +59,14 @@ extern int score;
 extern int counterTail;
 
 extern Food fruits[FOOD_ITEMS];
+extern int foodCount;
 extern Snake snake[SNAKE_LENGTH];
 extern const float tileSize;
 
-extern const int mapWidth;
-extern const int mapHeight;
+extern int mapWidth;
+extern int mapHeight;
+extern int mapTilesX;
+extern int mapTilesY;
 extern int borderWidth;
 extern int offMapSize;
 
@@ -56,7 +75,7 @@ extern int offMapSize;
 // Main Functions Declaration
 //------------------------------------------------------------------------------------
 void InitGame(void);         // Initialize game
-void UpdateGame(void);       // Update game (one frame)
+void UpdateGame(int ticks);  // Update game (one frame, ticks simulation steps)
 void DrawGame(void);         // Draw game (one frame)
 void UnloadGame(void);       // Unload game
 void UpdateDrawFrame(void);  // Update and Draw (one frame)
@@ -66,22 +85,31 @@ void DrawUI(void);
 // Map Functions Declaration
 //----------------------------------------------------------------------------------
 void InitMap(void);
+void ResetMap(void);
+void InitFruits(void);      // Fruit grid over mapWidth x mapHeight, InitMap() calls it
+int GetFruitGridSize(void); // World arena bytes the fruit grid needs, size the arena with it before InitFruits()
+void ResetFruits(void);
+void UnloadFruits(void);
 void CalcFruitPos(void);
-void DrawMap(void);
+void BakeMap(Camera2D camera);
+void DrawMap(Camera2D camera);
+int QueryFruitsInArea(Rectangle area, int *indices, int maxCount);
+Rectangle GetCameraWorldRect(Camera2D camera);
 void UnloadMap(void);
 void UpdateCameraCenterInsideMap(Camera2D *camera, int screenWidth, int screenHeight);
-unsigned char** AssignColors(Color* colors);
+void UpdateMapStreaming(Camera2D camera, Vector2 head);
 
 //----------------------------------------------------------------------------------
 // Snake Functions Declaration
 //----------------------------------------------------------------------------------
 void InitSnake(void);
 void SetSnakeAsCameraTarget(Camera2D *camera);
-void UpdateMovement(Camera2D *camera);
+void UpdateMovement(Camera2D *camera, SimInput input);
 bool CalcWallCollision(void);
 bool CalcSelfCollision(void);
 void CalcFruitCollision(void);
-void DrawSnake(void);
+void DrawSnake(Camera2D camera);
+void ToggleSnakeTube(void);
 void MoveSnake(void);
 bool FruitIsOnSnake(Food fruit);
 
@@ -0,0 +1,284 @@
+#include "include/raylib.h"
+#include "include/rlgl.h"
+#include "memtrack.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+//----------------------------------------------------------------------------------
+// Some Defines
+//----------------------------------------------------------------------------------
+#define MEM_HEADER_SIZE         16          // Keeps the malloc alignment for the caller
+#define MEM_HEADER_MAGIC        0x4d454d54u
+#define MEM_MAX_TEXTURES        256
+#define MEM_PANEL_WIDTH         330
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+typedef struct MemHeader {
+    size_t size;
+    int tag;
+    unsigned int magic;
+} MemHeader;
+
+typedef struct TrackedTexture {
+    unsigned int id;
+    int tag;
+    long long bytes;
+} TrackedTexture;
+
+//----------------------------------------------------------------------------------
+// Module Variables Definition (local)
+//----------------------------------------------------------------------------------
+static const char *tagNames[MEM_TAGS] = { "general", "arena", "assets", "bake", "map", "render", "sim", "terrain" };
+static MemTagStats tagStats[MEM_TAGS] = { 0 };      // Updated atomically, allocations come from any thread
+static TrackedTexture textures[MEM_MAX_TEXTURES] = { 0 };   // GL thread only
+static int textureCount = 0;
+static bool untrackedWarned = false;
+
+#if defined(DEBUG_OVERLAY)
+static bool overlayVisible = false;
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition (local)
+//----------------------------------------------------------------------------------
+static void AddHeapBytes(int tag, long long bytes, long long blocks)
+{
+    long long live = __atomic_add_fetch(&tagStats[tag].heapBytes, bytes, __ATOMIC_RELAXED);
+    __atomic_add_fetch(&tagStats[tag].allocations, blocks, __ATOMIC_RELAXED);
+
+    long long peak = __atomic_load_n(&tagStats[tag].heapPeak, __ATOMIC_RELAXED);
+    while ((live > peak) && !__atomic_compare_exchange_n(&tagStats[tag].heapPeak, &peak, live, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) { }
+}
+
+static MemHeader *GetHeader(void *ptr)
+{
+    MemHeader *header = (MemHeader *)((unsigned char *)ptr - MEM_HEADER_SIZE);
+    if (header->magic == MEM_HEADER_MAGIC) return header;
+
+    // Memory raylib allocated must go back through raylib, this only keeps the mistake from being fatal
+    if (!untrackedWarned) TraceLog(LOG_WARNING, "MEMTRACK: Untracked pointer passed to RL_FREE/RL_REALLOC");
+    untrackedWarned = true;
+
+    return NULL;
+}
+
+static int ClampTag(int tag)
+{
+    return ((tag >= 0) && (tag < MEM_TAGS)) ? tag : MEM_GENERAL;
+}
+
+static long long GetTextureBytes(int width, int height, int format, int mipmaps)
+{
+    long long bytes = 0;
+
+    for (int level = 0; level < ((mipmaps > 1) ? mipmaps : 1); level++)
+    {
+        int levelWidth = width >> level;
+        int levelHeight = height >> level;
+        bytes += GetPixelDataSize((levelWidth > 0) ? levelWidth : 1, (levelHeight > 0) ? levelHeight : 1, format);
+    }
+
+    return bytes;
+}
+
+static void AddTexture(int tag, unsigned int id, long long bytes)
+{
+    if (id == 0) return;
+
+    tag = ClampTag(tag);
+    if (textureCount < MEM_MAX_TEXTURES) textures[textureCount++] = (TrackedTexture){ id, tag, bytes };
+    else TraceLog(LOG_WARNING, "MEMTRACK: More than %i textures, [%s] texture %u not tracked", MEM_MAX_TEXTURES, tagNames[tag], id);
+
+    __atomic_add_fetch(&tagStats[tag].gpuBytes, bytes, __ATOMIC_RELAXED);
+    __atomic_add_fetch(&tagStats[tag].textures, 1, __ATOMIC_RELAXED);
+}
+
+static void RemoveTexture(unsigned int id)
+{
+    for (int i = 0; i < textureCount; i++)
+    {
+        if (textures[i].id != id) continue;
+
+        __atomic_sub_fetch(&tagStats[textures[i].tag].gpuBytes, textures[i].bytes, __ATOMIC_RELAXED);
+        __atomic_sub_fetch(&tagStats[textures[i].tag].textures, 1, __ATOMIC_RELAXED);
+        textures[i] = textures[--textureCount];
+        return;
+    }
+}
+
+//----------------------------------------------------------------------------------
+// Memory Tracking Functions Definition
+//----------------------------------------------------------------------------------
+void *TrackedAlloc(int tag, size_t size)
+{
+    MemHeader *header = (MemHeader *)malloc(size + MEM_HEADER_SIZE);
+    if (header == NULL) return NULL;
+
+    tag = ClampTag(tag);
+    *header = (MemHeader){ size, tag, MEM_HEADER_MAGIC };
+    AddHeapBytes(tag, (long long)size, 1);
+
+    return (unsigned char *)header + MEM_HEADER_SIZE;
+}
+
+void *TrackedCalloc(int tag, size_t count, size_t size)
+{
+    MemHeader *header = (MemHeader *)calloc(1, count * size + MEM_HEADER_SIZE);
+    if (header == NULL) return NULL;
+
+    tag = ClampTag(tag);
+    *header = (MemHeader){ count * size, tag, MEM_HEADER_MAGIC };
+    AddHeapBytes(tag, (long long)(count * size), 1);
+
+    return (unsigned char *)header + MEM_HEADER_SIZE;
+}
+
+void *TrackedRealloc(int tag, void *ptr, size_t size)
+{
+    if (ptr == NULL) return TrackedAlloc(tag, size);
+
+    MemHeader *header = GetHeader(ptr);
+    if (header == NULL) return realloc(ptr, size);
+
+    MemHeader old = *header;
+    header = (MemHeader *)realloc(header, size + MEM_HEADER_SIZE);
+    if (header == NULL) return NULL;
+
+    tag = ClampTag(tag);
+    AddHeapBytes(old.tag, -(long long)old.size, -1);
+    AddHeapBytes(tag, (long long)size, 1);
+    *header = (MemHeader){ size, tag, MEM_HEADER_MAGIC };
+
+    return (unsigned char *)header + MEM_HEADER_SIZE;
+}
+
+void TrackedFree(void *ptr)
+{
+    if (ptr == NULL) return;
+
+    MemHeader *header = GetHeader(ptr);
+    if (header == NULL)
+    {
+        free(ptr);
+        return;
+    }
+
+    AddHeapBytes(header->tag, -(long long)header->size, -1);
+    header->magic = 0;
+    free(header);
+}
+
+Texture2D TrackTexture(int tag, Texture2D texture)
+{
+    AddTexture(tag, texture.id, GetTextureBytes(texture.width, texture.height, texture.format, texture.mipmaps));
+    return texture;
+}
+
+RenderTexture2D TrackRenderTexture(int tag, RenderTexture2D target)
+{
+    // Color attachment plus a 32 bit depth buffer, counted together under the color texture
+    long long bytes = GetTextureBytes(target.texture.width, target.texture.height, target.texture.format, 1);
+    if (target.depth.id != 0) bytes += (long long)target.depth.width * target.depth.height * 4;
+
+    AddTexture(tag, target.texture.id, bytes);
+    return target;
+}
+
+unsigned int TrackTextureId(int tag, unsigned int id, int width, int height, int format, int mipmaps)
+{
+    AddTexture(tag, id, GetTextureBytes(width, height, format, mipmaps));
+    return id;
+}
+
+void UnloadTrackedTexture(Texture2D texture)
+{
+    RemoveTexture(texture.id);
+    UnloadTexture(texture);
+}
+
+void UnloadTrackedRenderTexture(RenderTexture2D target)
+{
+    RemoveTexture(target.texture.id);
+    UnloadRenderTexture(target);
+}
+
+void UnloadTrackedTextureId(unsigned int id)
+{
+    RemoveTexture(id);
+    rlUnloadTexture(id);
+}
+
+MemTagStats GetMemTagStats(int tag)
+{
+    MemTagStats stats = { 0 };
+    if ((tag < 0) || (tag >= MEM_TAGS)) return stats;
+
+    stats.heapBytes = __atomic_load_n(&tagStats[tag].heapBytes, __ATOMIC_RELAXED);
+    stats.heapPeak = __atomic_load_n(&tagStats[tag].heapPeak, __ATOMIC_RELAXED);
+    stats.allocations = __atomic_load_n(&tagStats[tag].allocations, __ATOMIC_RELAXED);
+    stats.gpuBytes = __atomic_load_n(&tagStats[tag].gpuBytes, __ATOMIC_RELAXED);
+    stats.textures = __atomic_load_n(&tagStats[tag].textures, __ATOMIC_RELAXED);
+
+    return stats;
+}
+
+const char *GetMemTagName(int tag)
+{
+    return ((tag >= 0) && (tag < MEM_TAGS)) ? tagNames[tag] : "unknown";
+}
+
+bool ReportMemoryLeaks(void)
+{
+    bool clean = true;
+
+    for (int tag = 0; tag < MEM_TAGS; tag++)
+    {
+        MemTagStats stats = GetMemTagStats(tag);
+        if ((stats.allocations == 0) && (stats.textures == 0)) continue;
+
+        TraceLog(LOG_WARNING, "MEMTRACK: [%s] Leaked %lld bytes in %lld blocks, %i textures (%lld bytes)", tagNames[tag],
+                 stats.heapBytes, stats.allocations, stats.textures, stats.gpuBytes);
+        clean = false;
+    }
+    for (int i = 0; i < textureCount; i++) TraceLog(LOG_WARNING, "MEMTRACK: [%s] Texture %u still loaded", tagNames[textures[i].tag], textures[i].id);
+
+    if (clean) TraceLog(LOG_INFO, "MEMTRACK: No leaks");
+
+    return clean;
+}
+
+#if defined(DEBUG_OVERLAY)
+void UpdateMemoryOverlay(void)
+{
+    if (IsKeyPressed(KEY_F4)) overlayVisible = !overlayVisible;
+}
+
+// Bottom left, one row per tag that holds anything
+void DrawMemoryOverlay(void)
+{
+    if (!overlayVisible) return;
+
+    int rows = 0;
+    for (int tag = 0; tag < MEM_TAGS; tag++) if ((tagStats[tag].heapPeak > 0) || (tagStats[tag].textures > 0)) rows++;
+
+    int x = 20;
+    int y = GetScreenHeight() - 40 - (rows + 1) * 14;
+    char text[96];
+
+    DrawRectangle(x - 10, y - 10, MEM_PANEL_WIDTH + 20, (rows + 1) * 14 + 20, Fade(BLACK, 0.75f));
+    DrawText("tag          heap KB   peak KB   gpu KB  tex", x, y, 10, WHITE);
+    y += 14;
+
+    for (int tag = 0; tag < MEM_TAGS; tag++)
+    {
+        MemTagStats stats = GetMemTagStats(tag);
+        if ((stats.heapPeak == 0) && (stats.textures == 0)) continue;
+
+        snprintf(text, sizeof(text), "%-10s %9lld %9lld %8lld %4i", tagNames[tag], stats.heapBytes / 1024, stats.heapPeak / 1024, stats.gpuBytes / 1024, stats.textures);
+        DrawText(text, x, y, 10, RAYWHITE);
+        y += 14;
+    }
+}
+#endif
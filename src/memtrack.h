@@ -0,0 +1,77 @@
+#ifndef MEMTRACK_H
+#define MEMTRACK_H
+
+#include <stddef.h>
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+typedef enum MemTag {
+    MEM_GENERAL = 0,
+    MEM_ARENA,
+    MEM_ASSETS,
+    MEM_BAKE,
+    MEM_MAP,
+    MEM_RENDER,
+    MEM_SIM,
+    MEM_TERRAIN,
+    MEM_TAGS
+} MemTag;
+
+typedef struct MemTagStats {
+    long long heapBytes;                // Live RL_MALLOC memory
+    long long heapPeak;
+    long long allocations;              // Live blocks
+    long long gpuBytes;                 // Estimated from size, format and mipmaps
+    int textures;
+} MemTagStats;
+
+//----------------------------------------------------------------------------------
+// Memory Tracking Functions Declaration
+//----------------------------------------------------------------------------------
+// A file defines MEM_TAG and includes this header after raylib.h/rlgl.h, its RL_MALLOC/RL_FREE and
+// texture loads are then counted under that tag. Memory raylib allocates internally is not seen:
+//     #define MEM_TAG MEM_TERRAIN
+//     #include "memtrack.h"
+void *TrackedAlloc(int tag, size_t size);
+void *TrackedCalloc(int tag, size_t count, size_t size);
+void *TrackedRealloc(int tag, void *ptr, size_t size);
+void TrackedFree(void *ptr);
+
+Texture2D TrackTexture(int tag, Texture2D texture);
+RenderTexture2D TrackRenderTexture(int tag, RenderTexture2D target);
+unsigned int TrackTextureId(int tag, unsigned int id, int width, int height, int format, int mipmaps);
+void UnloadTrackedTexture(Texture2D texture);
+void UnloadTrackedRenderTexture(RenderTexture2D target);
+void UnloadTrackedTextureId(unsigned int id);
+
+MemTagStats GetMemTagStats(int tag);
+const char *GetMemTagName(int tag);
+bool ReportMemoryLeaks(void);           // After everything is unloaded, false when something is still live
+
+#if defined(DEBUG_OVERLAY)
+void UpdateMemoryOverlay(void);         // F4 toggles the breakdown
+void DrawMemoryOverlay(void);
+#else
+    #define UpdateMemoryOverlay()
+    #define DrawMemoryOverlay()
+#endif
+
+#if defined(MEM_TAG)
+    #undef RL_MALLOC
+    #undef RL_CALLOC
+    #undef RL_REALLOC
+    #undef RL_FREE
+    #define RL_MALLOC(sz)           TrackedAlloc(MEM_TAG, sz)
+    #define RL_CALLOC(n, sz)        TrackedCalloc(MEM_TAG, n, sz)
+    #define RL_REALLOC(ptr, sz)     TrackedRealloc(MEM_TAG, ptr, sz)
+    #define RL_FREE(ptr)            TrackedFree(ptr)
+
+    #define LoadTextureFromImage(image)     TrackTexture(MEM_TAG, LoadTextureFromImage(image))
+    #define UnloadTexture(texture)          UnloadTrackedTexture(texture)
+    #define LoadRenderTexture(w, h)         TrackRenderTexture(MEM_TAG, LoadRenderTexture(w, h))
+    #define UnloadRenderTexture(target)     UnloadTrackedRenderTexture(target)
+    #define rlLoadTexture(data, w, h, format, mipmaps)  TrackTextureId(MEM_TAG, rlLoadTexture(data, w, h, format, mipmaps), w, h, format, mipmaps)
+    #define rlUnloadTexture(id)             UnloadTrackedTextureId(id)
+#endif
+
+#endif
@@ -0,0 +1,338 @@
+#include "include/raylib.h"
+#include "mapObjects.h"
+#include "pacer.h"
+#include "arena.h"
+#include "memtrack.h"
+#include "metrics.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#if !defined(_WIN32) && !defined(PLATFORM_WEB)
+    #include <arpa/inet.h>
+    #include <netinet/in.h>
+    #include <poll.h>
+    #include <pthread.h>
+    #include <sys/socket.h>
+    #include <sys/time.h>
+    #include <unistd.h>
+    #define METRICS_HTTP        // Served by a background thread
+#endif
+
+//----------------------------------------------------------------------------------
+// Some Defines
+//----------------------------------------------------------------------------------
+#define METRICS_SCRAPE_TIMEOUT  250     // Milliseconds a scrape waits for a fresh snapshot
+#define METRICS_CLIENT_TIMEOUT  500     // Milliseconds a client gets to send its request or take the response
+#define METRICS_BODY_SIZE       4096    // Starting size, grown when the exposition outgrows it
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+typedef struct MetricsSnapshot {
+    unsigned long long counters[METRIC_COUNTERS];
+    unsigned long long tickBuckets[METRICS_TICK_BUCKETS + 1];  // Last one is +Inf
+    unsigned long long ticks;
+    double tickSeconds;
+    int snakes;
+    int segments;
+    int liveFruit;
+    unsigned int missedFrames;
+    MemArena arenas[3];                 // Only the counters are used
+    MemTagStats memory[MEM_TAGS];
+    long residentBytes;
+} MetricsSnapshot;
+
+//----------------------------------------------------------------------------------
+// Global Variables Definition
+//----------------------------------------------------------------------------------
+unsigned long long metricCounters[METRIC_COUNTERS] = { 0 };
+
+//----------------------------------------------------------------------------------
+// Module Variables Definition (local)
+//----------------------------------------------------------------------------------
+static const double tickBucketBounds[METRICS_TICK_BUCKETS] = {
+    0.0001, 0.00025, 0.0005, 0.001, 0.0025, 0.005, 0.01, 0.016, 0.025, 0.05
+};
+static unsigned long long tickBuckets[METRICS_TICK_BUCKETS + 1] = { 0 };
+static unsigned long long ticks = 0;
+static double tickSeconds = 0.0;
+static double tickStart = 0.0;
+
+#if defined(METRICS_HTTP)
+static pthread_t serverThread;
+static pthread_mutex_t metricsMutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t snapshotReady = PTHREAD_COND_INITIALIZER;
+static bool serverRunning = false;
+static bool scrapeWaiting = false;      // Set by the server, checked with one atomic load per frame
+static unsigned int snapshotSerial = 0;
+static MetricsSnapshot snapshot = { 0 };
+static int listenSocket = -1;
+static char *body = NULL;               // Server thread only
+static int bodyCapacity = 0;
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition (local)
+//----------------------------------------------------------------------------------
+static double GetMetricsTime(void)
+{
+#if defined(_WIN32)
+    return GetTime();
+#else
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec * 1e-9;
+#endif
+}
+
+#if defined(METRICS_HTTP)
+static long GetResidentBytes(void)
+{
+    long pages = 0;
+    FILE *statm = fopen("/proc/self/statm", "r");
+    if (statm == NULL) return 0;
+
+    if (fscanf(statm, "%*d %ld", &pages) != 1) pages = 0;
+    fclose(statm);
+
+    return pages * sysconf(_SC_PAGESIZE);
+}
+
+// Returns the full length even when it does not fit in size, like snprintf. Formats only the snapshot,
+// so a second pass into a buffer grown to the first length gives the same output
+static int FormatMetrics(char *body, int size, const MetricsSnapshot *s)
+{
+    int length = 0;
+
+#define APPEND(...) length += snprintf((length < size) ? body + length : NULL, (length < size) ? size - length : 0, __VA_ARGS__)
+    APPEND("# HELP snake_tick_seconds Simulation tick duration.\n# TYPE snake_tick_seconds histogram\n");
+    unsigned long long cumulative = 0;
+    for (int i = 0; i < METRICS_TICK_BUCKETS; i++)
+    {
+        cumulative += s->tickBuckets[i];
+        APPEND("snake_tick_seconds_bucket{le=\"%g\"} %llu\n", tickBucketBounds[i], cumulative);
+    }
+    APPEND("snake_tick_seconds_bucket{le=\"+Inf\"} %llu\n", s->ticks);
+    APPEND("snake_tick_seconds_sum %.9f\nsnake_tick_seconds_count %llu\n", s->tickSeconds, s->ticks);
+
+    APPEND("# HELP snake_snakes Snakes in play.\n# TYPE snake_snakes gauge\nsnake_snakes %i\n", s->snakes);
+    APPEND("# HELP snake_segments Body segments of all snakes.\n# TYPE snake_segments gauge\nsnake_segments %i\n", s->segments);
+    APPEND("# HELP snake_fruit_live Active fruit on the map.\n# TYPE snake_fruit_live gauge\nsnake_fruit_live %i\n", s->liveFruit);
+    APPEND("# HELP snake_fruit_spawns_total Fruit spawned, use rate() for spawns per second.\n# TYPE snake_fruit_spawns_total counter\n"
+           "snake_fruit_spawns_total %llu\n", s->counters[METRIC_FRUIT_SPAWNS]);
+    APPEND("# HELP snake_fruit_pickups_total Fruit eaten, use rate() for pickups per second.\n# TYPE snake_fruit_pickups_total counter\n"
+           "snake_fruit_pickups_total %llu\n", s->counters[METRIC_FRUIT_PICKUPS]);
+    APPEND("# HELP snake_missed_frames_total Frames over 1.5 frame intervals.\n# TYPE snake_missed_frames_total counter\n"
+           "snake_missed_frames_total %u\n", s->missedFrames);
+    APPEND("# HELP snake_arena_high_water_bytes Most bytes used between resets.\n# TYPE snake_arena_high_water_bytes gauge\n");
+    for (int i = 0; i < 3; i++) APPEND("snake_arena_high_water_bytes{arena=\"%s\"} %zu\n", s->arenas[i].name, s->arenas[i].highWater);
+    APPEND("# HELP snake_arena_capacity_bytes Arena block size.\n# TYPE snake_arena_capacity_bytes gauge\n");
+    for (int i = 0; i < 3; i++) APPEND("snake_arena_capacity_bytes{arena=\"%s\"} %zu\n", s->arenas[i].name, s->arenas[i].capacity);
+    APPEND("# HELP snake_arena_failures_total Allocations that did not fit.\n# TYPE snake_arena_failures_total counter\n");
+    for (int i = 0; i < 3; i++) APPEND("snake_arena_failures_total{arena=\"%s\"} %u\n", s->arenas[i].name, s->arenas[i].failures);
+    APPEND("# HELP snake_memory_bytes Live tracked memory per subsystem, gpu is estimated.\n# TYPE snake_memory_bytes gauge\n");
+    for (int tag = 0; tag < MEM_TAGS; tag++)
+    {
+        APPEND("snake_memory_bytes{tag=\"%s\",kind=\"heap\"} %lld\n", GetMemTagName(tag), s->memory[tag].heapBytes);
+        APPEND("snake_memory_bytes{tag=\"%s\",kind=\"gpu\"} %lld\n", GetMemTagName(tag), s->memory[tag].gpuBytes);
+    }
+    APPEND("# HELP snake_resident_bytes Resident set size of the process.\n# TYPE snake_resident_bytes gauge\nsnake_resident_bytes %ld\n", s->residentBytes);
+#undef APPEND
+
+    return length;
+}
+
+// Ask the main thread for a snapshot, falls back to the previous one when no frame comes (e.g. window dragged)
+static MetricsSnapshot WaitForSnapshot(void)
+{
+    pthread_mutex_lock(&metricsMutex);
+
+    unsigned int serial = snapshotSerial;
+    __atomic_store_n(&scrapeWaiting, true, __ATOMIC_RELAXED);
+
+    struct timespec deadline;
+    clock_gettime(CLOCK_REALTIME, &deadline);
+    deadline.tv_nsec += METRICS_SCRAPE_TIMEOUT * 1000000L;
+    if (deadline.tv_nsec >= 1000000000L)
+    {
+        deadline.tv_sec++;
+        deadline.tv_nsec -= 1000000000L;
+    }
+    while ((snapshotSerial == serial) && (pthread_cond_timedwait(&snapshotReady, &metricsMutex, &deadline) == 0)) { }
+
+    MetricsSnapshot result = snapshot;
+    pthread_mutex_unlock(&metricsMutex);
+
+    return result;
+}
+
+static void ServeRequest(int client)
+{
+    char request[1024] = { 0 };
+    char header[256];
+
+    // One thread serves everyone, a client that connects and goes quiet must not hold it (or shutdown) up
+    struct timeval timeout = { METRICS_CLIENT_TIMEOUT / 1000, (METRICS_CLIENT_TIMEOUT % 1000) * 1000 };
+    setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    setsockopt(client, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+
+    ssize_t received = recv(client, request, sizeof(request) - 1, 0);
+    if (received <= 0) return;
+
+    if (strncmp(request, "GET /metrics", 12) != 0)
+    {
+        const char *notFound = "HTTP/1.0 404 Not Found\r\nContent-Length: 0\r\nConnection: close\r\n\r\n";
+        send(client, notFound, strlen(notFound), MSG_NOSIGNAL);
+        return;
+    }
+
+    MetricsSnapshot current = WaitForSnapshot();
+    int bodyLength = FormatMetrics(body, bodyCapacity, &current);
+    if (bodyLength >= bodyCapacity)
+    {
+        int capacity = (bodyLength >= METRICS_BODY_SIZE) ? bodyLength + 1 : METRICS_BODY_SIZE;
+        char *grown = (char *)RL_REALLOC(body, capacity);
+        if (grown == NULL)
+        {
+            TraceLog(LOG_WARNING, "METRICS: No memory for a %i byte response", bodyLength);
+            const char *unavailable = "HTTP/1.0 503 Service Unavailable\r\nContent-Length: 0\r\nConnection: close\r\n\r\n";
+            send(client, unavailable, strlen(unavailable), MSG_NOSIGNAL);
+            return;
+        }
+
+        body = grown;
+        bodyCapacity = capacity;
+        bodyLength = FormatMetrics(body, bodyCapacity, &current);
+    }
+    if (bodyLength >= bodyCapacity) bodyLength = bodyCapacity - 1;
+    int headerLength = snprintf(header, sizeof(header), "HTTP/1.0 200 OK\r\nContent-Type: text/plain; version=0.0.4\r\n"
+                                "Content-Length: %i\r\nConnection: close\r\n\r\n", bodyLength);
+
+    send(client, header, headerLength, MSG_NOSIGNAL);
+    send(client, body, bodyLength, MSG_NOSIGNAL);
+}
+
+static void *ServerThread(void *arg)
+{
+    while (__atomic_load_n(&serverRunning, __ATOMIC_RELAXED))
+    {
+        // Wake up regularly to notice shutdown
+        struct pollfd listener = { listenSocket, POLLIN, 0 };
+        if (poll(&listener, 1, 200) <= 0) continue;
+
+        int client = accept(listenSocket, NULL, NULL);
+        if (client < 0) continue;
+
+        ServeRequest(client);
+        close(client);
+    }
+
+    return NULL;
+}
+#endif
+
+//----------------------------------------------------------------------------------
+// Metrics Functions Definition
+//----------------------------------------------------------------------------------
+void InitMetrics(int port)
+{
+#if defined(METRICS_HTTP)
+    if ((port <= 0) || serverRunning) return;
+
+    listenSocket = socket(AF_INET, SOCK_STREAM, 0);
+    if (listenSocket < 0) return;
+
+    int reuse = 1;
+    setsockopt(listenSocket, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+    // Local only, put a proxy in front to expose it
+    struct sockaddr_in address = { 0 };
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    if ((bind(listenSocket, (struct sockaddr *)&address, sizeof(address)) != 0) || (listen(listenSocket, 4) != 0))
+    {
+        TraceLog(LOG_WARNING, "METRICS: Failed to listen on port %i", port);
+        close(listenSocket);
+        listenSocket = -1;
+        return;
+    }
+
+    serverRunning = true;
+    if (pthread_create(&serverThread, NULL, ServerThread, NULL) != 0)
+    {
+        serverRunning = false;
+        close(listenSocket);
+        listenSocket = -1;
+        return;
+    }
+
+    TraceLog(LOG_INFO, "METRICS: Serving http://127.0.0.1:%i/metrics", port);
+#else
+    if (port > 0) TraceLog(LOG_WARNING, "METRICS: HTTP endpoint not available on this platform");
+#endif
+}
+
+void UnloadMetrics(void)
+{
+#if defined(METRICS_HTTP)
+    if (!serverRunning) return;
+
+    __atomic_store_n(&serverRunning, false, __ATOMIC_RELAXED);
+    pthread_join(serverThread, NULL);
+    close(listenSocket);
+    listenSocket = -1;
+    RL_FREE(body);
+    body = NULL;
+    bodyCapacity = 0;
+#endif
+}
+
+void BeginMetricsTick(void)
+{
+    tickStart = GetMetricsTime();
+}
+
+void EndMetricsTick(void)
+{
+    double seconds = GetMetricsTime() - tickStart;
+    int bucket = 0;
+    while ((bucket < METRICS_TICK_BUCKETS) && (seconds > tickBucketBounds[bucket])) bucket++;
+
+    tickBuckets[bucket]++;
+    tickSeconds += seconds;
+    ticks++;
+}
+
+void PublishMetrics(void)
+{
+#if defined(METRICS_HTTP)
+    if (!__atomic_load_n(&scrapeWaiting, __ATOMIC_RELAXED)) return;
+
+    // Only paid for when someone scrapes
+    MetricsSnapshot current = { 0 };
+    memcpy(current.counters, metricCounters, sizeof(metricCounters));
+    memcpy(current.tickBuckets, tickBuckets, sizeof(tickBuckets));
+    current.ticks = ticks;
+    current.tickSeconds = tickSeconds;
+    current.snakes = 1;
+    current.segments = counterTail;
+    for (int i = 0; i < foodCount; i++) if (fruits[i].active) current.liveFruit++;
+    current.missedFrames = GetFramePacerStats().missedDeadlines;
+    current.arenas[0] = simArena;
+    current.arenas[1] = frameArena;
+    current.arenas[2] = worldArena;
+    for (int tag = 0; tag < MEM_TAGS; tag++) current.memory[tag] = GetMemTagStats(tag);
+    current.residentBytes = GetResidentBytes();
+
+    pthread_mutex_lock(&metricsMutex);
+    snapshot = current;
+    snapshotSerial++;
+    __atomic_store_n(&scrapeWaiting, false, __ATOMIC_RELAXED);
+    pthread_cond_broadcast(&snapshotReady);
+    pthread_mutex_unlock(&metricsMutex);
+#endif
+}
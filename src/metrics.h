@@ -0,0 +1,37 @@
+#ifndef METRICS_H
+#define METRICS_H
+//----------------------------------------------------------------------------------
+// Some Defines
+//----------------------------------------------------------------------------------
+#define METRICS_TICK_BUCKETS    10      // Tick duration histogram buckets, see tickBucketBounds
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+typedef enum MetricCounter {
+    METRIC_FRUIT_SPAWNS = 0,
+    METRIC_FRUIT_PICKUPS,
+    METRIC_COUNTERS
+} MetricCounter;
+
+//----------------------------------------------------------------------------------
+// Global Variables Definition
+//----------------------------------------------------------------------------------
+// Owned by whichever thread runs the simulation step (the sim thread, or the main thread on web). The main
+// thread reads them only after WaitForSimulation(), never bump them from the main thread while a step runs
+extern unsigned long long metricCounters[METRIC_COUNTERS];
+
+//----------------------------------------------------------------------------------
+// Metrics Functions Declaration
+//----------------------------------------------------------------------------------
+// Prometheus text format on http://127.0.0.1:<port>/metrics. The simulation only bumps plain
+// counters, a snapshot is taken by PublishMetrics() when a scrape is waiting for one
+#define CountMetric(counter)    (metricCounters[counter]++)
+
+void InitMetrics(int port);             // 0 leaves the endpoint off, counters still count
+void UnloadMetrics(void);
+void BeginMetricsTick(void);
+void EndMetricsTick(void);              // Adds the tick duration to the histogram
+void PublishMetrics(void);              // Once per frame on the main thread
+
+#endif
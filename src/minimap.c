@@ -0,0 +1,48 @@
+#include "include/raylib.h"
+#include "mapObjects.h"
+#include "tilemap.h"
+#include "atlas.h"
+#include "bake.h"
+#include "circles.h"
+#include "sim.h"
+#include "minimap.h"
+
+//----------------------------------------------------------------------------------
+// Module Variables Definition (local)
+//----------------------------------------------------------------------------------
+static bool minimapVisible = true;
+
+//----------------------------------------------------------------------------------
+// Minimap Functions Definition
+//----------------------------------------------------------------------------------
+void UpdateMinimap(void)
+{
+    if (IsKeyPressed(KEY_M)) minimapVisible = !minimapVisible;
+}
+
+// One textured quad for the terrain, then every marker as a small quad in the same shapes batch
+void DrawMinimap(Camera2D camera)
+{
+    Texture2D overview = GetTerrainOverview();
+    if (!minimapVisible || (overview.id == 0)) return;
+
+    float scale = (float)MINIMAP_SIZE / MAX(mapWidth, mapHeight);
+    Rectangle frame = { GetScreenWidth() - MINIMAP_MARGIN - mapWidth * scale, GetScreenHeight() - MINIMAP_MARGIN - mapHeight * scale, mapWidth * scale, mapHeight * scale };
+
+    DrawTexturePro(overview, (Rectangle){ 0, 0, overview.width, overview.height }, frame, (Vector2){ 0.0f, 0.0f }, 0.0f, WHITE);
+
+    // Fruit, already capped at MINIMAP_MAX_FRUIT_DOTS by the simulation
+    const RenderPacket *packet = GetRenderPacket();
+    for (int i = 0; i < packet->markerCount; i++)
+    {
+        DrawRectangleV((Vector2){ frame.x + packet->markers[i].x * scale - 1, frame.y + packet->markers[i].y * scale - 1 }, (Vector2){ 2, 2 }, RED);
+    }
+
+    // Visible area and snake head
+    Rectangle view = GetCameraWorldRect(camera);
+    view = GetCollisionRec(view, (Rectangle){ 0, 0, mapWidth, mapHeight });
+    DrawRectangleLinesEx((Rectangle){ frame.x + view.x * scale, frame.y + view.y * scale, MAX(view.width * scale, 2), MAX(view.height * scale, 2) }, 1, RAYWHITE);
+    DrawRectangleV((Vector2){ frame.x + packet->head.x * scale - 2, frame.y + packet->head.y * scale - 2 }, (Vector2){ 4, 4 }, packet->headColor);
+
+    DrawRectangleLinesEx((Rectangle){ frame.x - 2, frame.y - 2, frame.width + 4, frame.height + 4 }, 2, BLACK);
+}
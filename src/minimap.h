@@ -0,0 +1,17 @@
+#ifndef MINIMAP_H
+#define MINIMAP_H
+//----------------------------------------------------------------------------------
+// Some Defines
+//----------------------------------------------------------------------------------
+#define MINIMAP_SIZE            180     // Screen pixels of the longest map side
+#define MINIMAP_MARGIN          20
+#define MINIMAP_MAX_FRUIT_DOTS  1024    // Fruit markers drawn per frame
+
+//----------------------------------------------------------------------------------
+// Minimap Functions Declaration
+//----------------------------------------------------------------------------------
+// Terrain comes from the baked overview (see BakeTerrainOverview()), only markers change per frame
+void UpdateMinimap(void);               // M toggles the minimap
+void DrawMinimap(Camera2D camera);      // Screen space, call after EndMode2D()
+
+#endif
@@ -0,0 +1,149 @@
+#include "include/raylib.h"
+#include "pacer.h"
+#include <math.h>
+#include <stdlib.h>
+
+#if !defined(_WIN32) && !defined(PLATFORM_WEB)
+    #include <time.h>
+#endif
+
+//----------------------------------------------------------------------------------
+// Some Defines
+//----------------------------------------------------------------------------------
+#define PACER_DEFAULT_RATE      60
+#define PACER_MAX_TICKS         4       // Per frame, anything beyond is dropped instead of spiralling
+#define PACER_TICK_SNAP         0.1     // Frame times this close to whole ticks count as whole ticks
+#define PACER_MIN_SPIN          0.0002
+#define PACER_MAX_SPIN          0.004
+
+//----------------------------------------------------------------------------------
+// Module Variables Definition (local)
+//----------------------------------------------------------------------------------
+static FramePacerStats stats = { PACER_DEFAULT_RATE, PACER_DEFAULT_RATE, false, 0, 0, 0.0f, 0.001f };
+static bool followRefresh = false;
+static double frameInterval = 1.0 / PACER_DEFAULT_RATE;
+static double tickInterval = 1.0 / PACER_DEFAULT_RATE;
+static double frameStart = 0.0;
+static double nextDeadline = 0.0;
+static double tickAccumulator = 0.0;
+static int refreshCheck = 0;
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition (local)
+//----------------------------------------------------------------------------------
+static void UpdatePacerRate(void)
+{
+    int refreshRate = GetMonitorRefreshRate(GetCurrentMonitor());
+    if (refreshRate <= 0) refreshRate = PACER_DEFAULT_RATE;
+
+    if (followRefresh) stats.targetFps = refreshRate;
+    frameInterval = 1.0 / stats.targetFps;
+
+    // With vsync at the refresh rate the swap blocks already, sleeping on top of it only adds misses
+    stats.vsync = IsWindowState(FLAG_VSYNC_HINT) && (abs(refreshRate - stats.targetFps) <= 1);
+}
+
+#if !defined(PLATFORM_WEB)
+static void SleepSeconds(double seconds)
+{
+#if defined(_WIN32)
+    WaitTime(seconds);
+#else
+    struct timespec duration = { (time_t)seconds, (long)((seconds - (time_t)seconds) * 1e9) };
+    nanosleep(&duration, NULL);
+#endif
+}
+#endif
+
+//----------------------------------------------------------------------------------
+// Frame Pacer Functions Definition
+//----------------------------------------------------------------------------------
+void InitFramePacer(int targetFps, int tickRate)
+{
+    followRefresh = (targetFps <= 0);
+    stats.targetFps = followRefresh ? PACER_DEFAULT_RATE : targetFps;
+    stats.tickRate = (tickRate > 0) ? tickRate : PACER_DEFAULT_RATE;
+    tickInterval = 1.0 / stats.tickRate;
+    UpdatePacerRate();
+
+    frameStart = GetTime();
+    nextDeadline = frameStart + frameInterval;
+    tickAccumulator = tickInterval;     // First frame runs one tick
+
+    TraceLog(LOG_INFO, "PACER: %i fps%s, %i ticks per second", stats.targetFps, stats.vsync ? " (vsync)" : "", stats.tickRate);
+}
+
+int BeginPacedFrame(void)
+{
+    double now = GetTime();
+    double frameTime = now - frameStart;
+    frameStart = now;
+
+    stats.frameTime = (float)frameTime;
+    if (frameTime > frameInterval * 1.5) stats.missedDeadlines++;
+
+    // Monitor could have changed under the window
+    if (followRefresh && (++refreshCheck >= stats.targetFps))
+    {
+        refreshCheck = 0;
+        UpdatePacerRate();
+    }
+
+    // Scheduling jitter around a whole number of ticks must not turn into 0/2 tick frames
+    double ticksElapsed = frameTime / tickInterval;
+    double wholeTicks = floor(ticksElapsed + 0.5);
+    if ((wholeTicks >= 1.0) && (fabs(ticksElapsed - wholeTicks) < PACER_TICK_SNAP)) frameTime = wholeTicks * tickInterval;
+
+    tickAccumulator += frameTime;
+    int ticks = (int)(tickAccumulator / tickInterval);
+    tickAccumulator -= ticks * tickInterval;
+
+    if (ticks > PACER_MAX_TICKS)
+    {
+        stats.droppedTicks += ticks - PACER_MAX_TICKS;
+        ticks = PACER_MAX_TICKS;
+    }
+
+    return ticks;
+}
+
+void EndPacedFrame(void)
+{
+#if !defined(PLATFORM_WEB)
+    // Web frames come from requestAnimationFrame, nothing to wait for
+    if (stats.vsync) return;
+
+    double now = GetTime();
+    if (now >= nextDeadline)
+    {
+        // Late: keep the cadence if it was a small slip, start over after a hitch
+        nextDeadline = (now - nextDeadline > frameInterval) ? now + frameInterval : nextDeadline + frameInterval;
+        return;
+    }
+
+    // Sleep is only trusted up to the overshoot seen so far, the rest is spun
+    double sleepTime = nextDeadline - now - stats.spinMargin;
+    if (sleepTime > 0.0)
+    {
+        SleepSeconds(sleepTime);
+
+        double overshoot = GetTime() - (now + sleepTime);
+        double margin = fmax(stats.spinMargin * 0.99, overshoot * 1.25);
+        stats.spinMargin = (float)fmin(fmax(margin, PACER_MIN_SPIN), PACER_MAX_SPIN);
+    }
+
+    while (GetTime() < nextDeadline) { }
+
+    nextDeadline += frameInterval;
+#endif
+}
+
+float GetTickTime(void)
+{
+    return (float)tickInterval;
+}
+
+FramePacerStats GetFramePacerStats(void)
+{
+    return stats;
+}
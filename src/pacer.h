@@ -0,0 +1,27 @@
+#ifndef PACER_H
+#define PACER_H
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+typedef struct FramePacerStats {
+    int targetFps;                      // Render rate being paced to
+    int tickRate;                       // Fixed simulation ticks per second
+    bool vsync;                         // Swap already waits for the display, pacer only measures
+    unsigned int missedDeadlines;       // Frames that took over 1.5 frame intervals
+    unsigned int droppedTicks;          // Simulation time thrown away after long hitches
+    float frameTime;                    // Last frame, seconds
+    float spinMargin;                   // Seconds spun instead of slept, follows the sleep overshoot
+} FramePacerStats;
+
+//----------------------------------------------------------------------------------
+// Frame Pacer Functions Declaration
+//----------------------------------------------------------------------------------
+// Replaces SetTargetFPS(): sleeps most of the remaining frame time and spins the rest, and hands out
+// fixed simulation ticks so the render rate can differ from the tick rate
+void InitFramePacer(int targetFps, int tickRate);  // targetFps 0 follows the monitor refresh rate
+int BeginPacedFrame(void);                         // Simulation ticks due this frame
+void EndPacedFrame(void);                          // Waits for the next frame deadline, after EndDrawing()
+float GetTickTime(void);                           // Fixed simulation step, seconds
+FramePacerStats GetFramePacerStats(void);
+
+#endif
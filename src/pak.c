@@ -0,0 +1,240 @@
+#include "include/raylib.h"
+#include "atlas.h"
+#include "pak.h"
+#include <string.h>
+
+#define PAK_MAX_IMAGE_SIZE  16384       // Keeps GetPixelDataSize() of any entry inside an int
+
+#if !defined(_WIN32) && !defined(PLATFORM_WEB)
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+    #define PAK_USE_MMAP
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition (local)
+//----------------------------------------------------------------------------------
+// Formats GetPakImage() users can upload or run through DecompressImageDXT()
+static bool IsPakFormat(int format)
+{
+    return (format == PIXELFORMAT_UNCOMPRESSED_R8G8B8A8) || (format == PIXELFORMAT_COMPRESSED_DXT1_RGB) ||
+           (format == PIXELFORMAT_COMPRESSED_DXT1_RGBA) || (format == PIXELFORMAT_COMPRESSED_DXT5_RGBA);
+}
+
+static bool IsValidPak(const Pak *pak)
+{
+    const PakHeader *header = (const PakHeader *)pak->data;
+    if ((pak->dataSize < sizeof(PakHeader)) || (memcmp(header->magic, "SPAK", 4) != 0) || (header->version != PAK_VERSION)) return false;
+    if ((size_t)header->indexOffset + (size_t)header->entryCount * sizeof(PakEntry) > pak->dataSize) return false;
+
+    const PakEntry *entries = (const PakEntry *)((const unsigned char *)pak->data + header->indexOffset);
+    for (unsigned int i = 0; i < header->entryCount; i++)
+    {
+        const PakEntry *entry = &entries[i];
+        if ((size_t)entry->offset + entry->size > pak->dataSize) return false;
+
+        // The blob must hold exactly the image it describes, the uploader and the DXT decoder trust it
+        if ((entry->width <= 0) || (entry->height <= 0) || (entry->width > PAK_MAX_IMAGE_SIZE) || (entry->height > PAK_MAX_IMAGE_SIZE)) return false;
+        if (!IsPakFormat(entry->format)) return false;
+        if ((entry->format != PIXELFORMAT_UNCOMPRESSED_R8G8B8A8) && (((entry->width % 4) != 0) || ((entry->height % 4) != 0))) return false;
+        if (entry->size != (unsigned int)GetPixelDataSize(entry->width, entry->height, entry->format)) return false;
+        if ((entry->type == PAK_ATLAS) && ((size_t)entry->layoutOffset + sizeof(PakAtlasLayout) > pak->dataSize)) return false;
+    }
+
+    return true;
+}
+
+static void Expand565(unsigned short value, unsigned char *rgb)
+{
+    rgb[0] = ((value >> 11) & 0x1f) * 255 / 31;
+    rgb[1] = ((value >> 5) & 0x3f) * 255 / 63;
+    rgb[2] = (value & 0x1f) * 255 / 31;
+}
+
+// BC1 color block, 4 colors or 3 plus black (transparent with punch-through alpha)
+static void DecodeColorBlock(const unsigned char *block, Color *out, bool alwaysFourColors, bool punchThrough)
+{
+    unsigned short c0 = block[0] | (block[1] << 8);
+    unsigned short c1 = block[2] | (block[3] << 8);
+    unsigned char palette[4][4] = { 0 };
+
+    Expand565(c0, palette[0]);
+    Expand565(c1, palette[1]);
+    palette[0][3] = palette[1][3] = 255;
+
+    for (int c = 0; c < 3; c++)
+    {
+        if (alwaysFourColors || (c0 > c1))
+        {
+            palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+            palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+        }
+        else palette[2][c] = (palette[0][c] + palette[1][c]) / 2;
+    }
+    palette[2][3] = 255;
+    palette[3][3] = (alwaysFourColors || (c0 > c1) || !punchThrough) ? 255 : 0;
+
+    unsigned int indices = block[4] | (block[5] << 8) | (block[6] << 16) | ((unsigned int)block[7] << 24);
+    for (int i = 0; i < 16; i++)
+    {
+        const unsigned char *color = palette[(indices >> (i * 2)) & 3];
+        out[i] = (Color){ color[0], color[1], color[2], color[3] };
+    }
+}
+
+// BC3 alpha block, 8 or 6 interpolated levels
+static void DecodeAlphaBlock(const unsigned char *block, Color *out)
+{
+    unsigned char levels[8] = { block[0], block[1] };
+
+    if (levels[0] > levels[1]) for (int i = 1; i < 7; i++) levels[i + 1] = ((7 - i) * levels[0] + i * levels[1]) / 7;
+    else
+    {
+        for (int i = 1; i < 5; i++) levels[i + 1] = ((5 - i) * levels[0] + i * levels[1]) / 5;
+        levels[6] = 0;
+        levels[7] = 255;
+    }
+
+    unsigned long long indices = 0;
+    for (int i = 0; i < 6; i++) indices |= (unsigned long long)block[2 + i] << (8 * i);
+    for (int i = 0; i < 16; i++) out[i].a = levels[(indices >> (i * 3)) & 7];
+}
+
+//----------------------------------------------------------------------------------
+// Pak Functions Definition
+//----------------------------------------------------------------------------------
+// Map a .pak archive into memory, blobs are used in place
+Pak LoadPak(const char *fileName)
+{
+    Pak pak = { 0 };
+
+#if defined(PAK_USE_MMAP)
+    int fd = open(fileName, O_RDONLY);
+    if (fd < 0) return pak;
+
+    struct stat st;
+    if (fstat(fd, &st) == 0 && st.st_size >= (off_t)sizeof(PakHeader))
+    {
+        void *data = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data != MAP_FAILED)
+        {
+            pak.data = data;
+            pak.dataSize = (size_t)st.st_size;
+        }
+    }
+    close(fd);
+#else
+    if (!FileExists(fileName)) return pak;
+
+    unsigned int bytesRead = 0;
+    pak.data = LoadFileData(fileName, &bytesRead);
+    pak.dataSize = bytesRead;
+#endif
+
+    if (pak.data == NULL) return pak;
+
+    if (!IsValidPak(&pak))
+    {
+        TraceLog(LOG_WARNING, "PAK: [%s] Invalid or outdated asset archive", fileName);
+        UnloadPak(pak);
+        return (Pak){ 0 };
+    }
+
+    pak.header = (const PakHeader *)pak.data;
+    pak.entries = (const PakEntry *)((const unsigned char *)pak.data + pak.header->indexOffset);
+    pak.entryCount = pak.header->entryCount;
+
+    TraceLog(LOG_INFO, "PAK: [%s] Asset archive loaded successfully (%i entries, %i KB)", fileName, pak.entryCount, (int)(pak.dataSize / 1024));
+
+    return pak;
+}
+
+void UnloadPak(Pak pak)
+{
+    if (pak.data == NULL) return;
+
+#if defined(PAK_USE_MMAP)
+    munmap(pak.data, pak.dataSize);
+#else
+    UnloadFileData(pak.data);
+#endif
+}
+
+const PakEntry *FindPakEntry(const Pak *pak, const char *name)
+{
+    for (int i = 0; i < pak->entryCount; i++)
+    {
+        if (strncmp(pak->entries[i].name, name, PAK_NAME_SIZE) == 0) return &pak->entries[i];
+    }
+    return NULL;
+}
+
+Image GetPakImage(const Pak *pak, const PakEntry *entry)
+{
+    return (Image){ (unsigned char *)pak->data + entry->offset, entry->width, entry->height, 1, entry->format };
+}
+
+bool GetPakAtlas(const Pak *pak, const PakEntry *entry, TextureAtlas *atlas)
+{
+    if (entry->type != PAK_ATLAS) return false;
+
+    const PakAtlasLayout *layout = (const PakAtlasLayout *)((const unsigned char *)pak->data + entry->layoutOffset);
+
+    *atlas = (TextureAtlas){ 0 };
+    atlas->count = layout->count;
+    atlas->white = layout->white;
+    for (int i = 0; i < ATLAS_MAX_SPRITES; i++)
+    {
+        atlas->sprites[i] = layout->sprites[i];
+        atlas->averages[i] = layout->averages[i];
+    }
+
+    return true;
+}
+
+// FNV-1a over the names, a prepacked atlas is only used when built from the same sprite list
+unsigned int HashPakNames(const char **names, int count)
+{
+    unsigned int hash = 2166136261u;
+
+    for (int i = 0; i < count; i++)
+    {
+        for (const char *c = names[i]; *c != '\0'; c++) hash = (hash ^ (unsigned char)*c) * 16777619u;
+        hash = (hash ^ '\n') * 16777619u;
+    }
+
+    return hash;
+}
+
+Image DecompressImageDXT(Image image)
+{
+    bool hasAlphaBlock = (image.format == PIXELFORMAT_COMPRESSED_DXT5_RGBA);
+    int blockBytes = hasAlphaBlock ? 16 : 8;
+    int blocksX = (image.width + 3) / 4;
+    int blocksY = (image.height + 3) / 4;
+
+    Image result = GenImageColor(image.width, image.height, BLANK);
+    Color *pixels = (Color *)result.data;
+    const unsigned char *block = (const unsigned char *)image.data;
+
+    for (int by = 0; by < blocksY; by++)
+    {
+        for (int bx = 0; bx < blocksX; bx++, block += blockBytes)
+        {
+            Color texels[16];
+            DecodeColorBlock(hasAlphaBlock ? block + 8 : block, texels, hasAlphaBlock, image.format == PIXELFORMAT_COMPRESSED_DXT1_RGBA);
+            if (hasAlphaBlock) DecodeAlphaBlock(block, texels);
+
+            for (int i = 0; i < 16; i++)
+            {
+                int x = bx * 4 + (i & 3);
+                int y = by * 4 + (i >> 2);
+                if ((x < image.width) && (y < image.height)) pixels[y * image.width + x] = texels[i];
+            }
+        }
+    }
+
+    return result;
+}
@@ -0,0 +1,64 @@
+#ifndef PAK_H
+#define PAK_H
+
+#include <stddef.h>
+//----------------------------------------------------------------------------------
+// Some Defines
+//----------------------------------------------------------------------------------
+#define PAK_VERSION         2
+#define PAK_NAME_SIZE       64      // Entry names are paths relative to resources/
+#define PAK_DATA_ALIGN      64
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+typedef enum PakEntryType { PAK_IMAGE = 0, PAK_ATLAS } PakEntryType;
+
+// On-disk layout: header, blobs (PAK_DATA_ALIGN aligned), then the entry index at indexOffset
+typedef struct PakHeader {
+    char magic[4];                  // "SPAK"
+    unsigned int version;
+    unsigned int entryCount;
+    unsigned int indexOffset;
+} PakHeader;
+
+typedef struct PakEntry {
+    char name[PAK_NAME_SIZE];
+    unsigned int type;              // PakEntryType
+    unsigned int offset;            // Pixel data, ready for upload
+    unsigned int size;
+    int width;
+    int height;
+    int format;                     // PixelFormat, uncompressed RGBA or DXT1/DXT5
+    unsigned int layoutOffset;      // PAK_ATLAS: PakAtlasLayout
+    unsigned int sourceHash;        // PAK_ATLAS: hash of the sprite file names, see HashPakNames()
+} PakEntry;
+
+// Sprite placement of a prepacked atlas, mirrors TextureAtlas without the texture
+typedef struct PakAtlasLayout {
+    int count;
+    Rectangle sprites[ATLAS_MAX_SPRITES];
+    Rectangle white;
+    Color averages[ATLAS_MAX_SPRITES];
+} PakAtlasLayout;
+
+typedef struct Pak {
+    const PakHeader *header;
+    const PakEntry *entries;
+    int entryCount;
+    void *data;                     // mmap view of the archive, or file data where mmap is missing
+    size_t dataSize;
+} Pak;
+
+//----------------------------------------------------------------------------------
+// Pak Functions Declaration
+//----------------------------------------------------------------------------------
+Pak LoadPak(const char *fileName);      // Returns a pak with data == NULL on failure
+void UnloadPak(Pak pak);
+const PakEntry *FindPakEntry(const Pak *pak, const char *name);
+Image GetPakImage(const Pak *pak, const PakEntry *entry);   // Points into the pak, don't UnloadImage() it
+bool GetPakAtlas(const Pak *pak, const PakEntry *entry, TextureAtlas *atlas);   // Layout only, no texture
+unsigned int HashPakNames(const char **names, int count);
+Image DecompressImageDXT(Image image);  // CPU fallback where the GPU lacks S3TC, returns a new RGBA image
+
+#endif
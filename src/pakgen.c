@@ -0,0 +1,329 @@
+/*******************************************************************************************
+*
+*   pakgen - offline asset packer
+*
+*   Decodes every listed image once and writes them into a single .pak archive, ready to be
+*   uploaded straight from the mapped file. Atlases are packed here too, so the game doesn't
+*   decode sprites or run the shelf packer at startup. With -dxt images whose size is a
+*   multiple of 4 are stored as DXT1 (opaque) or DXT5, cutting file size and VRAM.
+*
+*   Usage: pakgen [-dxt] <resources dir> <output.pak> <entries...>
+*       image entry:    textures/stone480.png
+*       atlas entry:    atlas/map=textures/03_Water.png,items/pizza64.png,...
+*
+********************************************************************************************/
+
+#include "include/raylib.h"
+#include "atlas.h"
+#include "pak.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define PAKGEN_MAX_ENTRIES  64
+#define PAKGEN_SPRITE_SIZE  256         // Longest sprite name listed in an atlas entry, with terminator
+#define PAKGEN_ROOT_SIZE    512         // Longest resources dir, with the separator
+
+//----------------------------------------------------------------------------------
+// Module Variables Definition (local)
+//----------------------------------------------------------------------------------
+static PakEntry entries[PAKGEN_MAX_ENTRIES] = { 0 };
+static int entryCount = 0;
+static unsigned char *blob = NULL;      // Everything after the header, in file order
+static size_t blobSize = 0;
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition (local)
+//----------------------------------------------------------------------------------
+// Append aligned data, returns its file offset
+static unsigned int AppendBlob(const void *data, size_t size)
+{
+    size_t offset = (sizeof(PakHeader) + blobSize + PAK_DATA_ALIGN - 1) & ~(size_t)(PAK_DATA_ALIGN - 1);
+    size_t start = offset - sizeof(PakHeader);
+
+    blob = (unsigned char *)realloc(blob, start + size);
+    memset(blob + blobSize, 0, start - blobSize);
+    memcpy(blob + start, data, size);
+    blobSize = start + size;
+
+    return (unsigned int)offset;
+}
+
+static unsigned short To565(const unsigned char *rgb)
+{
+    return ((rgb[0] * 31 + 127) / 255 << 11) | ((rgb[1] * 63 + 127) / 255 << 5) | ((rgb[2] * 31 + 127) / 255);
+}
+
+static void From565(unsigned short value, int *rgb)
+{
+    rgb[0] = ((value >> 11) & 0x1f) * 255 / 31;
+    rgb[1] = ((value >> 5) & 0x3f) * 255 / 63;
+    rgb[2] = (value & 0x1f) * 255 / 31;
+}
+
+// BC1 in 4 color mode, endpoints from the inset bounding box of the block
+static void EncodeColorBlock(const Color *texels, unsigned char *out)
+{
+    unsigned char min[3] = { 255, 255, 255 };
+    unsigned char max[3] = { 0, 0, 0 };
+
+    for (int i = 0; i < 16; i++)
+    {
+        const unsigned char rgb[3] = { texels[i].r, texels[i].g, texels[i].b };
+        for (int c = 0; c < 3; c++)
+        {
+            if (rgb[c] < min[c]) min[c] = rgb[c];
+            if (rgb[c] > max[c]) max[c] = rgb[c];
+        }
+    }
+
+    for (int c = 0; c < 3; c++)
+    {
+        int inset = (max[c] - min[c]) / 16;
+        min[c] += inset;
+        max[c] -= inset;
+    }
+
+    unsigned short c0 = To565(max);
+    unsigned short c1 = To565(min);
+    if (c0 < c1)
+    {
+        unsigned short swap = c0;
+        c0 = c1;
+        c1 = swap;
+    }
+
+    int palette[4][3];
+    From565(c0, palette[0]);
+    From565(c1, palette[1]);
+    for (int c = 0; c < 3; c++)
+    {
+        palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+        palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+    }
+
+    unsigned int indices = 0;
+    if (c0 != c1)
+    {
+        for (int i = 0; i < 16; i++)
+        {
+            int best = 0;
+            int bestError = 0x7fffffff;
+            for (int p = 0; p < 4; p++)
+            {
+                int dr = texels[i].r - palette[p][0], dg = texels[i].g - palette[p][1], db = texels[i].b - palette[p][2];
+                int error = dr * dr + dg * dg + db * db;
+                if (error < bestError)
+                {
+                    bestError = error;
+                    best = p;
+                }
+            }
+            indices |= (unsigned int)best << (i * 2);
+        }
+    }
+
+    out[0] = c0 & 0xff;
+    out[1] = c0 >> 8;
+    out[2] = c1 & 0xff;
+    out[3] = c1 >> 8;
+    for (int i = 0; i < 4; i++) out[4 + i] = (indices >> (i * 8)) & 0xff;
+}
+
+// BC3 alpha in 8 level mode
+static void EncodeAlphaBlock(const Color *texels, unsigned char *out)
+{
+    unsigned char a0 = 0, a1 = 255;
+    for (int i = 0; i < 16; i++)
+    {
+        if (texels[i].a > a0) a0 = texels[i].a;
+        if (texels[i].a < a1) a1 = texels[i].a;
+    }
+
+    int levels[8] = { a0, a1 };
+    for (int i = 1; i < 7; i++) levels[i + 1] = ((7 - i) * a0 + i * a1) / 7;
+
+    unsigned long long indices = 0;
+    if (a0 != a1)
+    {
+        for (int i = 0; i < 16; i++)
+        {
+            int best = 0;
+            for (int l = 1; l < 8; l++) if (abs(texels[i].a - levels[l]) < abs(texels[i].a - levels[best])) best = l;
+            indices |= (unsigned long long)best << (i * 3);
+        }
+    }
+
+    out[0] = a0;
+    out[1] = a1;
+    for (int i = 0; i < 6; i++) out[2 + i] = (indices >> (i * 8)) & 0xff;
+}
+
+// Compress an RGBA image (size multiple of 4) into DXT1 if fully opaque, DXT5 otherwise
+static Image CompressImageDXT(Image image)
+{
+    Color *pixels = (Color *)image.data;
+    bool opaque = true;
+    for (int i = 0; i < image.width * image.height; i++) if (pixels[i].a < 255) opaque = false;
+
+    int format = opaque ? PIXELFORMAT_COMPRESSED_DXT1_RGB : PIXELFORMAT_COMPRESSED_DXT5_RGBA;
+    int blockBytes = opaque ? 8 : 16;
+    unsigned char *data = (unsigned char *)malloc((size_t)(image.width / 4) * (image.height / 4) * blockBytes);
+    unsigned char *block = data;
+
+    for (int by = 0; by < image.height / 4; by++)
+    {
+        for (int bx = 0; bx < image.width / 4; bx++, block += blockBytes)
+        {
+            Color texels[16];
+            for (int i = 0; i < 16; i++) texels[i] = pixels[(by * 4 + (i >> 2)) * image.width + bx * 4 + (i & 3)];
+
+            if (opaque) EncodeColorBlock(texels, block);
+            else
+            {
+                EncodeAlphaBlock(texels, block);
+                EncodeColorBlock(texels, block + 8);
+            }
+        }
+    }
+
+    return (Image){ data, image.width, image.height, 1, format };
+}
+
+// Store image pixels (converted and compressed as requested), fills the image part of the entry
+static void AddImageData(PakEntry *entry, Image image, bool dxt)
+{
+    ImageFormat(&image, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+
+    if (dxt && (image.width % 4 == 0) && (image.height % 4 == 0))
+    {
+        Image compressed = CompressImageDXT(image);
+        UnloadImage(image);
+        image = compressed;
+    }
+
+    entry->width = image.width;
+    entry->height = image.height;
+    entry->format = image.format;
+    entry->size = GetPixelDataSize(image.width, image.height, image.format);
+    entry->offset = AppendBlob(image.data, entry->size);
+
+    UnloadImage(image);
+}
+
+static bool AddEntry(const char *root, const char *argument, bool dxt)
+{
+    if (entryCount >= PAKGEN_MAX_ENTRIES) return false;
+
+    PakEntry *entry = &entries[entryCount];
+    const char *separator = strchr(argument, '=');
+    size_t nameLength = (separator != NULL) ? (size_t)(separator - argument) : strlen(argument);
+    if (nameLength >= PAK_NAME_SIZE) return false;
+
+    memset(entry, 0, sizeof(PakEntry));
+    memcpy(entry->name, argument, nameLength);
+
+    if (separator == NULL)
+    {
+        Image image = LoadImage(TextFormat("%s/%s", root, argument));
+        if (image.data == NULL) return false;
+
+        entry->type = PAK_IMAGE;
+        AddImageData(entry, image, dxt);
+    }
+    else
+    {
+        // Sprite names as listed are what the game hashes, paths are resolved against root
+        // A truncated name would hash differently from the game's list and the pak would never be used
+        static char names[ATLAS_MAX_SPRITES][PAKGEN_SPRITE_SIZE];
+        static char paths[ATLAS_MAX_SPRITES][PAKGEN_ROOT_SIZE + PAKGEN_SPRITE_SIZE];
+        const char *nameList[ATLAS_MAX_SPRITES] = { 0 };
+        const char *pathList[ATLAS_MAX_SPRITES] = { 0 };
+        int count = 0;
+
+        for (const char *start = separator + 1; (*start != '\0') && (count < ATLAS_MAX_SPRITES - 1); count++)
+        {
+            const char *end = strchr(start, ',');
+            size_t length = (end != NULL) ? (size_t)(end - start) : strlen(start);
+            int nameLength = snprintf(names[count], sizeof(names[count]), "%.*s", (int)length, start);
+            int pathLength = snprintf(paths[count], sizeof(paths[count]), "%s/%s", root, names[count]);
+            if ((nameLength < 0) || ((size_t)nameLength >= sizeof(names[count])) ||
+                (pathLength < 0) || ((size_t)pathLength >= sizeof(paths[count])))
+            {
+                TraceLog(LOG_ERROR, "PAK: [%.*s] Sprite name or resources dir too long", (int)length, start);
+                return false;
+            }
+            nameList[count] = names[count];
+            pathList[count] = paths[count];
+            start += length + ((end != NULL) ? 1 : 0);
+        }
+
+        TextureAtlas atlas = { 0 };
+        Image packed = LoadAtlasImage(pathList, count, &atlas);
+        if (packed.data == NULL) return false;
+
+        PakAtlasLayout layout = { 0 };
+        layout.count = atlas.count;
+        layout.white = atlas.white;
+        for (int i = 0; i < ATLAS_MAX_SPRITES; i++)
+        {
+            layout.sprites[i] = atlas.sprites[i];
+            layout.averages[i] = atlas.averages[i];
+        }
+
+        entry->type = PAK_ATLAS;
+        entry->sourceHash = HashPakNames(nameList, count);
+        AddImageData(entry, packed, dxt);
+        entry->layoutOffset = AppendBlob(&layout, sizeof(layout));
+    }
+
+    TraceLog(LOG_INFO, "PAK: [%s] Added %s (%ix%i, %u KB)", entry->name, (entry->type == PAK_ATLAS) ? "atlas" : "image",
+             entry->width, entry->height, entry->size / 1024);
+    entryCount++;
+
+    return true;
+}
+
+int main(int argc, char *argv[])
+{
+    int first = 1;
+    bool dxt = false;
+
+    if ((argc > 1) && (strcmp(argv[1], "-dxt") == 0))
+    {
+        dxt = true;
+        first++;
+    }
+
+    if (argc < first + 3)
+    {
+        printf("Usage: %s [-dxt] <resources dir> <output.pak> <entries...>\n", argv[0]);
+        return 1;
+    }
+
+    SetTraceLogLevel(LOG_WARNING);
+
+    for (int i = first + 2; i < argc; i++)
+    {
+        if (!AddEntry(argv[first], argv[i], dxt))
+        {
+            TraceLog(LOG_ERROR, "PAK: [%s] Failed to add entry", argv[i]);
+            return 1;
+        }
+    }
+
+    PakHeader header = { { 'S', 'P', 'A', 'K' }, PAK_VERSION, entryCount, 0 };
+    header.indexOffset = AppendBlob(entries, entryCount * sizeof(PakEntry));
+
+    FILE *file = fopen(argv[first + 1], "wb");
+    if (file == NULL) return 1;
+
+    bool success = (fwrite(&header, sizeof(header), 1, file) == 1) && (fwrite(blob, 1, blobSize, file) == blobSize);
+    fclose(file);
+    free(blob);
+
+    if (success) TraceLog(LOG_WARNING, "PAK: [%s] Archive written (%i entries, %i KB)", argv[first + 1], entryCount, (int)((sizeof(header) + blobSize) / 1024));
+    else TraceLog(LOG_ERROR, "PAK: [%s] Failed to write archive", argv[first + 1]);
+
+    return success ? 0 : 1;
+}
@@ -0,0 +1,474 @@
+#include "include/raylib.h"
+#include "profile.h"
+#include <stdio.h>
+#include <string.h>
+
+#if defined(PROFILER)
+#include <time.h>
+#if !defined(PLATFORM_WEB)
+    #include <pthread.h>
+    #define PROFILE_THREADED
+#endif
+
+//----------------------------------------------------------------------------------
+// Some Defines
+//----------------------------------------------------------------------------------
+#define PROFILE_FLAME_EVENTS    256     // Main thread zones of the last frame kept for the flame chart
+#define PROFILE_AVERAGE_FRAMES  30
+#define PROFILE_PANEL_WIDTH     380
+#define PROFILE_ROW_HEIGHT      16
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+typedef struct ProfileThread {
+    char name[32];
+    ProfileEvent events[PROFILE_RING_SIZE];
+    unsigned long long head;            // Events written so far, published with release stores
+    unsigned long long readCursor;      // Events already collected by ProfileFrame()
+    unsigned long long traceCursor;     // Events already written to the trace
+    unsigned long long stackStart[PROFILE_MAX_DEPTH];
+    short stackZone[PROFILE_MAX_DEPTH];
+    int depth;                          // Can exceed PROFILE_MAX_DEPTH, deeper zones are dropped
+} ProfileThread;
+
+//----------------------------------------------------------------------------------
+// Module Variables Definition (local)
+//----------------------------------------------------------------------------------
+static ProfileThread threads[PROFILE_MAX_THREADS] = { 0 };
+static int threadCount = 0;
+static __thread ProfileThread *currentThread = NULL;
+static __thread bool currentThreadFull = false;
+
+static char zoneNames[PROFILE_MAX_ZONES][32] = { 0 };
+static int zoneCount = 0;
+#if defined(PROFILE_THREADED)
+static pthread_mutex_t zoneMutex = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+// Collected on the main thread
+static float zoneHistory[PROFILE_MAX_ZONES][PROFILE_HISTORY] = { 0 };  // Inclusive ms per frame
+static float frameHistory[PROFILE_HISTORY] = { 0 };
+static bool zoneTopLevel[PROFILE_MAX_ZONES] = { 0 };    // Seen outermost on the main thread, stacked in the graph
+static int historyIndex = 0;
+static unsigned long long frameStart = 0;
+static ProfileEvent flameEvents[PROFILE_FLAME_EVENTS] = { 0 };
+static int flameCount = 0;
+static unsigned long long flameStart = 0;
+static unsigned long long flameEnd = 0;
+static bool overlayVisible = false;
+
+// Trace writer, the file and cursors belong to whoever drains (writer thread, or ProfileFrame() without one)
+static FILE *traceFile = NULL;
+static unsigned long long traceStart = 0;
+static unsigned long long traceEvents = 0;
+static unsigned long long traceLost = 0;
+static bool traceThreadNamed[PROFILE_MAX_THREADS] = { 0 };
+#if defined(PROFILE_THREADED)
+static pthread_t traceThread;
+static pthread_mutex_t traceMutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t traceWake = PTHREAD_COND_INITIALIZER;
+static bool traceRunning = false;
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition (local)
+//----------------------------------------------------------------------------------
+static ProfileThread *GetProfileThread(void)
+{
+    if ((currentThread != NULL) || currentThreadFull) return currentThread;
+
+    int index = __atomic_fetch_add(&threadCount, 1, __ATOMIC_RELAXED);
+    if (index >= PROFILE_MAX_THREADS)
+    {
+        currentThreadFull = true;
+        return NULL;
+    }
+
+    currentThread = &threads[index];
+    snprintf(currentThread->name, sizeof(currentThread->name), "thread %i", index);
+
+    return currentThread;
+}
+
+static int InternProfileZone(const char *name)
+{
+    int zone = -1;
+
+#if defined(PROFILE_THREADED)
+    pthread_mutex_lock(&zoneMutex);
+#endif
+    for (int i = 0; i < zoneCount; i++)
+    {
+        if (strcmp(zoneNames[i], name) == 0) zone = i;
+    }
+
+    if ((zone < 0) && (zoneCount < PROFILE_MAX_ZONES))
+    {
+        zone = zoneCount;
+        snprintf(zoneNames[zone], sizeof(zoneNames[zone]), "%s", name);
+        __atomic_store_n(&zoneCount, zoneCount + 1, __ATOMIC_RELEASE);
+    }
+#if defined(PROFILE_THREADED)
+    pthread_mutex_unlock(&zoneMutex);
+#endif
+
+    return zone;
+}
+
+// Copy the next unread event of a thread, false when caught up. Events the writer overwrote
+// before they were read are skipped
+static bool ReadProfileEvent(ProfileThread *thread, unsigned long long *cursor, ProfileEvent *event)
+{
+    unsigned long long head = __atomic_load_n(&thread->head, __ATOMIC_ACQUIRE);
+    if (head - *cursor > PROFILE_RING_SIZE) *cursor = head - PROFILE_RING_SIZE;
+    if (*cursor == head) return false;
+
+    *event = thread->events[*cursor & (PROFILE_RING_SIZE - 1)];
+
+    // Lapped while copying, the copy may be torn
+    head = __atomic_load_n(&thread->head, __ATOMIC_ACQUIRE);
+    if (head - *cursor > PROFILE_RING_SIZE - 1)
+    {
+        *cursor = head - PROFILE_RING_SIZE + 1;
+        return ReadProfileEvent(thread, cursor, event);
+    }
+
+    (*cursor)++;
+    return true;
+}
+
+// Write everything recorded since the last pass as complete ("X") events
+static void DrainProfileTrace(void)
+{
+    int threadTotal = __atomic_load_n(&threadCount, __ATOMIC_ACQUIRE);
+    int zones = __atomic_load_n(&zoneCount, __ATOMIC_ACQUIRE);
+    if (threadTotal > PROFILE_MAX_THREADS) threadTotal = PROFILE_MAX_THREADS;
+
+    for (int t = 0; t < threadTotal; t++)
+    {
+        ProfileThread *thread = &threads[t];
+        unsigned long long head = __atomic_load_n(&thread->head, __ATOMIC_ACQUIRE);
+
+        if (!traceThreadNamed[t] && (head > 0))
+        {
+            // Names are set before a thread records its first zone
+            fprintf(traceFile, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%i,\"args\":{\"name\":\"%s\"}}", t, thread->name);
+            traceThreadNamed[t] = true;
+        }
+
+        if (head - thread->traceCursor > PROFILE_RING_SIZE) traceLost += head - thread->traceCursor - PROFILE_RING_SIZE;
+
+        ProfileEvent event;
+        while (ReadProfileEvent(thread, &thread->traceCursor, &event))
+        {
+            if ((event.start < traceStart) || (event.zone < 0) || (event.zone >= zones)) continue;
+
+            fprintf(traceFile, ",\n{\"name\":\"%s\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%i}",
+                    zoneNames[event.zone], (event.start - traceStart) / 1e3, (event.end - event.start) / 1e3, t);
+            traceEvents++;
+        }
+    }
+}
+
+#if defined(PROFILE_THREADED)
+static void *TraceThread(void *arg)
+{
+    pthread_mutex_lock(&traceMutex);
+
+    while (traceRunning)
+    {
+        struct timespec wake;
+        clock_gettime(CLOCK_REALTIME, &wake);
+        wake.tv_nsec += PROFILE_TRACE_INTERVAL * 1000000L;
+        if (wake.tv_nsec >= 1000000000L)
+        {
+            wake.tv_sec++;
+            wake.tv_nsec -= 1000000000L;
+        }
+        pthread_cond_timedwait(&traceWake, &traceMutex, &wake);
+
+        pthread_mutex_unlock(&traceMutex);
+        DrainProfileTrace();
+        pthread_mutex_lock(&traceMutex);
+    }
+
+    pthread_mutex_unlock(&traceMutex);
+
+    return NULL;
+}
+#endif
+
+static bool IsTraceWriterRunning(void)
+{
+#if defined(PROFILE_THREADED)
+    return traceRunning;
+#else
+    return false;
+#endif
+}
+
+static Color GetZoneColor(int zone)
+{
+    return ColorFromHSV((float)((zone * 47) % 360), 0.6f, 0.9f);
+}
+
+static float GetZoneAverage(int zone)
+{
+    float sum = 0.0f;
+    for (int i = 1; i <= PROFILE_AVERAGE_FRAMES; i++) sum += zoneHistory[zone][(historyIndex - i + PROFILE_HISTORY) % PROFILE_HISTORY];
+    return sum / PROFILE_AVERAGE_FRAMES;
+}
+
+static float GetZoneMax(int zone)
+{
+    float max = 0.0f;
+    for (int i = 0; i < PROFILE_HISTORY; i++) if (zoneHistory[zone][i] > max) max = zoneHistory[zone][i];
+    return max;
+}
+
+// Main thread zones of the last frame, one row per nesting level
+static void DrawFlameChart(int x, int y, int width)
+{
+    float scale = (flameEnd > flameStart) ? (float)width / (float)(flameEnd - flameStart) : 0.0f;
+
+    for (int i = 0; i < flameCount; i++)
+    {
+        const ProfileEvent *event = &flameEvents[i];
+        int left = x + (int)((event->start - flameStart) * scale);
+        int right = x + (int)((event->end - flameStart) * scale);
+        int top = y + event->depth * PROFILE_ROW_HEIGHT;
+        if (right <= left) right = left + 1;
+
+        DrawRectangle(left, top, right - left, PROFILE_ROW_HEIGHT - 1, GetZoneColor(event->zone));
+        if (MeasureText(zoneNames[event->zone], 10) < right - left - 4) DrawText(zoneNames[event->zone], left + 2, top + 3, 10, BLACK);
+    }
+}
+
+// Stacked outermost main thread zones per frame, the white mark is the whole frame
+static void DrawHistoryGraph(int x, int y, int width, int height)
+{
+    const float maxMs = 33.3f;
+    float columnWidth = (float)width / PROFILE_HISTORY;
+
+    DrawLine(x, y + height - (int)(16.7f / maxMs * height), x + width, y + height - (int)(16.7f / maxMs * height), DARKGREEN);
+
+    for (int i = 0; i < PROFILE_HISTORY; i++)
+    {
+        int frame = (historyIndex + i) % PROFILE_HISTORY;
+        int column = x + (int)(i * columnWidth);
+        float stacked = 0.0f;
+
+        for (int zone = 0; zone < zoneCount; zone++)
+        {
+            float ms = zoneHistory[zone][frame];
+            if (!zoneTopLevel[zone] || (ms <= 0.0f)) continue;
+
+            int top = y + height - (int)((stacked + ms) / maxMs * height);
+            int bottom = y + height - (int)(stacked / maxMs * height);
+            if (top < y) top = y;
+            if (bottom > top) DrawRectangle(column, top, (int)columnWidth + 1, bottom - top, GetZoneColor(zone));
+            stacked += ms;
+        }
+
+        int frameTop = y + height - (int)(frameHistory[frame] / maxMs * height);
+        DrawRectangle(column, (frameTop < y) ? y : frameTop, (int)columnWidth + 1, 1, WHITE);
+    }
+}
+
+//----------------------------------------------------------------------------------
+// Profiler Functions Definition
+//----------------------------------------------------------------------------------
+unsigned long long GetProfileTime(void)
+{
+#if defined(_WIN32)
+    return (unsigned long long)(GetTime() * 1e9);
+#else
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (unsigned long long)now.tv_sec * 1000000000ull + (unsigned long long)now.tv_nsec;
+#endif
+}
+
+void SetProfileThreadName(const char *name)
+{
+    ProfileThread *thread = GetProfileThread();
+    if (thread != NULL) snprintf(thread->name, sizeof(thread->name), "%s", name);
+}
+
+void BeginProfileZone(int *zoneCache, const char *name)
+{
+    ProfileThread *thread = GetProfileThread();
+    if (thread == NULL) return;
+
+    int zone = __atomic_load_n(zoneCache, __ATOMIC_RELAXED);
+    if (zone < 0)
+    {
+        zone = InternProfileZone(name);
+        __atomic_store_n(zoneCache, zone, __ATOMIC_RELAXED);
+    }
+
+    if ((thread->depth < PROFILE_MAX_DEPTH) && (zone >= 0))
+    {
+        thread->stackZone[thread->depth] = zone;
+        thread->stackStart[thread->depth] = GetProfileTime();
+    }
+    else if (thread->depth < PROFILE_MAX_DEPTH) thread->stackZone[thread->depth] = -1;
+    thread->depth++;
+}
+
+void EndProfileZone(void)
+{
+    ProfileThread *thread = currentThread;
+    if ((thread == NULL) || (thread->depth == 0)) return;
+
+    int depth = --thread->depth;
+    if ((depth >= PROFILE_MAX_DEPTH) || (thread->stackZone[depth] < 0)) return;
+
+    unsigned long long head = thread->head;
+    thread->events[head & (PROFILE_RING_SIZE - 1)] = (ProfileEvent){ thread->stackStart[depth], GetProfileTime(), thread->stackZone[depth], depth };
+    __atomic_store_n(&thread->head, head + 1, __ATOMIC_RELEASE);
+
+#if defined(PROFILE_THREADED)
+    // Half a ring recorded, wake the writer early so it doesn't get lapped
+    if ((((head + 1) & (PROFILE_RING_SIZE/2 - 1)) == 0) && __atomic_load_n(&traceRunning, __ATOMIC_RELAXED)) pthread_cond_signal(&traceWake);
+#endif
+}
+
+void ProfileFrame(void)
+{
+    GetProfileThread();
+
+    unsigned long long now = GetProfileTime();
+    float zoneMs[PROFILE_MAX_ZONES] = { 0 };
+    int threadTotal = __atomic_load_n(&threadCount, __ATOMIC_RELAXED);
+    if (threadTotal > PROFILE_MAX_THREADS) threadTotal = PROFILE_MAX_THREADS;
+
+    flameCount = 0;
+    for (int t = 0; t < threadTotal; t++)
+    {
+        ProfileEvent event;
+        while (ReadProfileEvent(&threads[t], &threads[t].readCursor, &event))
+        {
+            if ((event.zone < 0) || (event.zone >= PROFILE_MAX_ZONES)) continue;
+            zoneMs[event.zone] += (float)(event.end - event.start) / 1e6f;
+
+            if (&threads[t] != currentThread) continue;
+            if (event.depth == 0) zoneTopLevel[event.zone] = true;
+            if (flameCount < PROFILE_FLAME_EVENTS) flameEvents[flameCount++] = event;
+        }
+    }
+
+    for (int zone = 0; zone < PROFILE_MAX_ZONES; zone++) zoneHistory[zone][historyIndex] = zoneMs[zone];
+    frameHistory[historyIndex] = (frameStart > 0) ? (float)(now - frameStart) / 1e6f : 0.0f;
+    historyIndex = (historyIndex + 1) % PROFILE_HISTORY;
+
+    flameStart = frameStart;
+    flameEnd = now;
+    frameStart = now;
+
+    if ((traceFile != NULL) && !IsTraceWriterRunning()) DrainProfileTrace();
+}
+
+void UpdateProfileOverlay(void)
+{
+    if (IsKeyPressed(KEY_F2)) overlayVisible = !overlayVisible;
+    if (IsKeyPressed(KEY_F3))
+    {
+        if (traceFile != NULL) StopProfileTrace();
+        else StartProfileTrace(TextFormat("trace_%lld.json", (long long)time(NULL)));
+    }
+}
+
+void DrawProfileOverlay(void)
+{
+    if (!overlayVisible) return;
+
+    int zones = __atomic_load_n(&zoneCount, __ATOMIC_ACQUIRE);
+    int x = GetScreenWidth() - PROFILE_PANEL_WIDTH - 10;
+    int y = 80;
+    int height = 20 + zones * 14 + PROFILE_MAX_DEPTH / 2 * PROFILE_ROW_HEIGHT + 100;
+    char text[64];
+
+    DrawRectangle(x - 10, y - 10, PROFILE_PANEL_WIDTH + 20, height, Fade(BLACK, 0.75f));
+    if (traceFile != NULL) DrawText("TRACE", x + PROFILE_PANEL_WIDTH - MeasureText("TRACE", 10), y, 10, RED);
+
+    float averageFrame = 0.0f;
+    for (int i = 1; i <= PROFILE_AVERAGE_FRAMES; i++) averageFrame += frameHistory[(historyIndex - i + PROFILE_HISTORY) % PROFILE_HISTORY];
+    snprintf(text, sizeof(text), "Frame %.2f ms (avg of %i)", averageFrame / PROFILE_AVERAGE_FRAMES, PROFILE_AVERAGE_FRAMES);
+    DrawText(text, x, y, 10, WHITE);
+    y += 16;
+
+    for (int zone = 0; zone < zones; zone++)
+    {
+        snprintf(text, sizeof(text), "%-20s %6.3f ms  max %6.3f", zoneNames[zone], GetZoneAverage(zone), GetZoneMax(zone));
+        DrawRectangle(x, y + 1, 8, 8, GetZoneColor(zone));
+        DrawText(text, x + 14, y, 10, RAYWHITE);
+        y += 14;
+    }
+
+    y += 6;
+    DrawFlameChart(x, y, PROFILE_PANEL_WIDTH);
+    y += PROFILE_MAX_DEPTH / 2 * PROFILE_ROW_HEIGHT;
+    DrawHistoryGraph(x, y, PROFILE_PANEL_WIDTH, 90);
+}
+
+bool StartProfileTrace(const char *fileName)
+{
+    if (traceFile != NULL) return false;
+
+    traceFile = fopen(fileName, "w");
+    if (traceFile == NULL)
+    {
+        TraceLog(LOG_WARNING, "PROFILE: [%s] Failed to open trace file", fileName);
+        return false;
+    }
+    setvbuf(traceFile, NULL, _IOFBF, 1 << 16);
+
+    // Only zones that begin from now on
+    int threadTotal = __atomic_load_n(&threadCount, __ATOMIC_ACQUIRE);
+    for (int t = 0; (t < threadTotal) && (t < PROFILE_MAX_THREADS); t++) threads[t].traceCursor = __atomic_load_n(&threads[t].head, __ATOMIC_ACQUIRE);
+    for (int t = 0; t < PROFILE_MAX_THREADS; t++) traceThreadNamed[t] = false;
+    traceStart = GetProfileTime();
+    traceEvents = traceLost = 0;
+
+    fprintf(traceFile, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"snake\"}}");
+
+#if defined(PROFILE_THREADED)
+    __atomic_store_n(&traceRunning, true, __ATOMIC_RELAXED);
+    if (pthread_create(&traceThread, NULL, TraceThread, NULL) != 0)
+    {
+        TraceLog(LOG_WARNING, "PROFILE: Failed to start trace writer, writing from the main thread");
+        __atomic_store_n(&traceRunning, false, __ATOMIC_RELAXED);
+    }
+#endif
+
+    TraceLog(LOG_INFO, "PROFILE: [%s] Trace started", fileName);
+
+    return true;
+}
+
+void StopProfileTrace(void)
+{
+    if (traceFile == NULL) return;
+
+#if defined(PROFILE_THREADED)
+    if (traceRunning)
+    {
+        pthread_mutex_lock(&traceMutex);
+        __atomic_store_n(&traceRunning, false, __ATOMIC_RELAXED);
+        pthread_cond_signal(&traceWake);
+        pthread_mutex_unlock(&traceMutex);
+        pthread_join(traceThread, NULL);
+    }
+#endif
+
+    DrainProfileTrace();
+    fprintf(traceFile, "\n]}\n");
+    fclose(traceFile);
+    traceFile = NULL;
+
+    if (traceLost > 0) TraceLog(LOG_WARNING, "PROFILE: Trace writer fell behind, %llu zones lost", traceLost);
+    TraceLog(LOG_INFO, "PROFILE: Trace stopped, %llu zones written", traceEvents);
+}
+#endif
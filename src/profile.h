@@ -0,0 +1,56 @@
+#ifndef PROFILE_H
+#define PROFILE_H
+//----------------------------------------------------------------------------------
+// Some Defines
+//----------------------------------------------------------------------------------
+#define PROFILE_MAX_ZONES       32
+#define PROFILE_MAX_THREADS     8
+#define PROFILE_MAX_DEPTH       16
+#define PROFILE_RING_SIZE       4096    // Zone events kept per thread, power of two
+#define PROFILE_HISTORY         240     // Frames shown in the overlay graph
+#define PROFILE_TRACE_INTERVAL  20      // Milliseconds between trace writer passes
+
+//----------------------------------------------------------------------------------
+// Profiler Functions Declaration
+//----------------------------------------------------------------------------------
+// Only built with PROFILER defined (Makefile DEBUG mode), release builds compile the zones out.
+// Zones are begin/end pairs on one thread, every thread records into its own ring buffer:
+//     PROFILE_BEGIN("MoveSnake");
+//     MoveSnake();
+//     PROFILE_END();
+#if defined(PROFILER)
+typedef struct ProfileEvent {
+    unsigned long long start;           // Nanoseconds, see GetProfileTime()
+    unsigned long long end;
+    short zone;
+    short depth;                        // Nesting level on its thread
+} ProfileEvent;
+
+unsigned long long GetProfileTime(void);
+void SetProfileThreadName(const char *name);    // Optional, call from the thread itself
+void BeginProfileZone(int *zoneCache, const char *name);
+void EndProfileZone(void);
+
+void ProfileFrame(void);                // Main thread, once per frame: collects the frame that just ended
+void UpdateProfileOverlay(void);        // F2 toggles the overlay, F3 starts/stops a trace
+void DrawProfileOverlay(void);
+
+// Streams zones of every thread to Chrome Trace Event JSON (chrome://tracing, ui.perfetto.dev).
+// A writer thread drains the rings and does the file IO, the tick only records as usual
+bool StartProfileTrace(const char *fileName);
+void StopProfileTrace(void);            // Also call at exit, finishes the file
+
+    #define PROFILE_BEGIN(name)     do { static int profileZone = -1; BeginProfileZone(&profileZone, name); } while (0)
+    #define PROFILE_END()           EndProfileZone()
+#else
+    #define PROFILE_BEGIN(name)
+    #define PROFILE_END()
+    #define SetProfileThreadName(name)
+    #define ProfileFrame()
+    #define UpdateProfileOverlay()
+    #define DrawProfileOverlay()
+    #define StartProfileTrace(fileName)     false
+    #define StopProfileTrace()
+#endif
+
+#endif
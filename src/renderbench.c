@@ -0,0 +1,201 @@
+#include "include/raylib.h"
+#include "include/raymath.h"
+#include "mapObjects.h"
+#include "stats.h"
+#include "atlas.h"
+#include "assets.h"
+#include "renderbench.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+//----------------------------------------------------------------------------------
+// Some Defines
+//----------------------------------------------------------------------------------
+#define RENDER_BENCH_WAYPOINTS  (int)(sizeof(waypoints) / sizeof(waypoints[0]))
+#define RENDER_BENCH_FRAMES     ((RENDER_BENCH_WAYPOINTS - 1) * RENDER_BENCH_SEGMENT_FRAMES)
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+typedef struct BenchWaypoint {
+    Vector2 position;           // Fraction of the map size
+    float zoom;                 // Clamped like in game, so tiny values mean the whole map
+    const char *label;          // Frames on the way here are reported under it
+} BenchWaypoint;
+
+typedef struct BenchFrame {
+    float ms;
+    int drawCalls;
+    int vertices;
+    int segment;
+} BenchFrame;
+
+//----------------------------------------------------------------------------------
+// Module Variables Definition (local)
+//----------------------------------------------------------------------------------
+static const BenchWaypoint waypoints[] = {
+    { { 0.5f, 0.5f }, 1.0f, "center" },
+    { { 0.55f, 0.45f }, 1.0f, "center" },
+    { { 0.0f, 0.0f }, 1.0f, "edges" },          // Corners and borders draw the off-map background
+    { { 1.0f, 0.0f }, 1.0f, "edges" },
+    { { 1.0f, 1.0f }, 0.5f, "edges" },
+    { { 0.5f, 0.5f }, 0.01f, "zoomed out" },
+    { { 0.5f, 0.5f }, 0.01f, "zoomed out" },
+    { { 0.3f, 0.6f }, 4.0f, "zoomed in" },
+    { { 0.35f, 0.6f }, 4.0f, "zoomed in" },
+};
+
+static const char *outputFile = NULL;
+static BenchFrame frames[RENDER_BENCH_FRAMES] = { 0 };
+static int frameCount = 0;
+static int warmupFrames = 0;
+static int pathFrame = -1;              // Frame being drawn, -1 while warming up
+static double lastFrameTime = 0.0;
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition (local)
+//----------------------------------------------------------------------------------
+static int CompareFloats(const void *a, const void *b)
+{
+    float x = *(const float *)a;
+    float y = *(const float *)b;
+    return (x > y) - (x < y);
+}
+
+// Nearest rank percentile of sorted values
+static float GetPercentile(const float *sorted, int count, float percentile)
+{
+    int rank = (int)ceilf(percentile / 100.0f * count) - 1;
+    return sorted[MAX(0, MIN(rank, count - 1))];
+}
+
+// Head on the path, body coiled around it so it stays on screen at every zoom
+static void PlaceSnake(Vector2 head, int frame)
+{
+    counterTail = RENDER_BENCH_SNAKE_LENGTH;
+    snake->position = head;
+
+    for (int i = 1; i < counterTail; i++)
+    {
+        float angle = frame * 0.05f + i * 0.08f;
+        float radius = 40.0f + i * 1.5f;
+        snake[i].position = (Vector2){ head.x + cosf(angle) * radius, head.y + sinf(angle) * radius };
+    }
+}
+
+static void WriteSegmentStats(FILE *out, const char *label, int segmentMask, bool last)
+{
+    static float times[RENDER_BENCH_FRAMES];
+    int count = 0;
+    double sumMs = 0.0, sumDraws = 0.0, sumVertices = 0.0;
+    int maxDraws = 0, maxVertices = 0;
+
+    for (int i = 0; i < frameCount; i++)
+    {
+        if (!(segmentMask & (1 << frames[i].segment))) continue;
+
+        times[count++] = frames[i].ms;
+        sumMs += frames[i].ms;
+        sumDraws += frames[i].drawCalls;
+        sumVertices += frames[i].vertices;
+        if (frames[i].drawCalls > maxDraws) maxDraws = frames[i].drawCalls;
+        if (frames[i].vertices > maxVertices) maxVertices = frames[i].vertices;
+    }
+    if (count == 0) return;
+
+    qsort(times, count, sizeof(float), CompareFloats);
+
+    fprintf(out, "    \"%s\": {\"frames\": %i, \"mean_ms\": %.3f, \"p50_ms\": %.3f, \"p95_ms\": %.3f, \"p99_ms\": %.3f, \"max_ms\": %.3f, "
+            "\"draw_calls_mean\": %.1f, \"draw_calls_max\": %i, \"vertices_mean\": %.0f, \"vertices_max\": %i}%s\n",
+            label, count, sumMs / count, GetPercentile(times, count, 50.0f), GetPercentile(times, count, 95.0f),
+            GetPercentile(times, count, 99.0f), times[count - 1], sumDraws / count, maxDraws, sumVertices / count, maxVertices, last ? "" : ",");
+
+    TraceLog(LOG_INFO, "BENCH: %-10s p50 %.2f ms  p95 %.2f ms  p99 %.2f ms  max %.2f ms  draws %.1f", label,
+             GetPercentile(times, count, 50.0f), GetPercentile(times, count, 95.0f), GetPercentile(times, count, 99.0f),
+             times[count - 1], sumDraws / count);
+}
+
+//----------------------------------------------------------------------------------
+// Render Benchmark Functions Definition
+//----------------------------------------------------------------------------------
+void InitRenderBench(const char *fileName)
+{
+    outputFile = fileName;
+    frameCount = 0;
+    warmupFrames = 0;
+    pathFrame = -1;
+    lastFrameTime = GetTime();
+}
+
+bool UpdateRenderBench(Camera2D *camera, int screenWidth, int screenHeight)
+{
+    double now = GetTime();
+
+    // Stats of the frame drawn since the last call
+    if (pathFrame >= 0)
+    {
+        RenderStats stats = GetRenderStats();
+        int segment = pathFrame / RENDER_BENCH_SEGMENT_FRAMES;
+        frames[frameCount++] = (BenchFrame){ (float)((now - lastFrameTime) * 1000.0), stats.drawCalls, stats.vertices, segment };
+    }
+    lastFrameTime = now;
+
+    // Textures in and the start area streamed before anything is recorded
+    if (pathFrame < 0)
+    {
+        if ((GetPendingAssets() == 0) && (++warmupFrames >= RENDER_BENCH_WARMUP_FRAMES)) pathFrame = 0;
+    }
+    else pathFrame++;
+
+    if (pathFrame >= RENDER_BENCH_FRAMES) return false;
+
+    int frame = (pathFrame < 0) ? 0 : pathFrame;
+    int segment = frame / RENDER_BENCH_SEGMENT_FRAMES;
+    float t = (float)(frame % RENDER_BENCH_SEGMENT_FRAMES) / RENDER_BENCH_SEGMENT_FRAMES;
+    const BenchWaypoint *from = &waypoints[segment];
+    const BenchWaypoint *to = &waypoints[segment + 1];
+
+    Vector2 fraction = Vector2Lerp(from->position, to->position, t);
+    PlaceSnake((Vector2){ fraction.x * mapWidth, fraction.y * mapHeight }, frame);
+
+    // Zoom changes geometrically, so each step looks the same
+    camera->zoom = expf(Lerp(logf(from->zoom), logf(to->zoom), t));
+    UpdateCameraCenterInsideMap(camera, screenWidth, screenHeight);
+
+    return true;
+}
+
+void UnloadRenderBench(void)
+{
+    if (outputFile == NULL) return;
+
+    FILE *out = fopen(outputFile, "w");
+    if (out == NULL)
+    {
+        TraceLog(LOG_WARNING, "BENCH: [%s] Failed to write render benchmark report", outputFile);
+        return;
+    }
+
+    fprintf(out, "{\n  \"screen\": [%i, %i],\n  \"segment_frames\": %i,\n  \"results\": {\n", GetScreenWidth(), GetScreenHeight(), RENDER_BENCH_SEGMENT_FRAMES);
+
+    // One entry per distinct label, then everything
+    for (int i = 1; i < RENDER_BENCH_WAYPOINTS; i++)
+    {
+        bool seen = false;
+        for (int j = 1; j < i; j++) if (strcmp(waypoints[j].label, waypoints[i].label) == 0) seen = true;
+        if (seen) continue;
+
+        int mask = 0;
+        for (int j = 1; j < RENDER_BENCH_WAYPOINTS; j++) if (strcmp(waypoints[j].label, waypoints[i].label) == 0) mask |= 1 << (j - 1);
+        WriteSegmentStats(out, waypoints[i].label, mask, false);
+    }
+    WriteSegmentStats(out, "all", ~0, true);
+
+    fprintf(out, "  }\n}\n");
+    fclose(out);
+
+    TraceLog(LOG_INFO, "BENCH: [%s] Render benchmark report written (%i frames)", outputFile, frameCount);
+    outputFile = NULL;
+}
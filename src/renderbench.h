@@ -0,0 +1,19 @@
+#ifndef RENDERBENCH_H
+#define RENDERBENCH_H
+//----------------------------------------------------------------------------------
+// Some Defines
+//----------------------------------------------------------------------------------
+#define RENDER_BENCH_SEGMENT_FRAMES     240     // Frames spent going from one waypoint to the next
+#define RENDER_BENCH_WARMUP_FRAMES      30      // Drawn after assets are in, not recorded
+#define RENDER_BENCH_SNAKE_LENGTH       400
+
+//----------------------------------------------------------------------------------
+// Render Benchmark Functions Declaration
+//----------------------------------------------------------------------------------
+// Drives the snake and camera along a scripted path over the map (center, edges, zoomed out
+// and in) and records frame times and render stats of every frame, see '--bench-render'
+void InitRenderBench(const char *outputFile);   // Call after InitGame()
+bool UpdateRenderBench(Camera2D *camera, int screenWidth, int screenHeight);  // Before drawing, false once the path is done
+void UnloadRenderBench(void);                   // Writes the JSON report
+
+#endif
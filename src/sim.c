@@ -0,0 +1,171 @@
+#include "include/raylib.h"
+#include "circles.h"
+#include "sim.h"
+#include "profile.h"
+#define MEM_TAG MEM_SIM
+#include "memtrack.h"
+#include <stdlib.h>
+
+#if !defined(PLATFORM_WEB)
+    #include <pthread.h>
+    #define SIM_THREADED            // Simulation steps run on a background thread
+#endif
+
+//----------------------------------------------------------------------------------
+// Some Defines
+//----------------------------------------------------------------------------------
+#define PACKET_FRESH            4       // Set next to the shared index when it holds an unread packet
+
+//----------------------------------------------------------------------------------
+// Module Variables Definition (local)
+//----------------------------------------------------------------------------------
+static void (*simulationStep)(void) = NULL;
+static RenderPacket packets[3] = { 0 };
+static int packetWriting = 0;           // Simulation side only
+static int packetReading = 1;           // Render side only
+static int packetShared = 2;            // Exchanged atomically, index | PACKET_FRESH
+static bool packetReceived = false;
+
+#if defined(SIM_THREADED)
+static pthread_t simThread;
+static pthread_mutex_t simMutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t simWake = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t simDone = PTHREAD_COND_INITIALIZER;
+static bool simRunning = false;
+static bool stepPending = false;        // Protected by simMutex
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition (local)
+//----------------------------------------------------------------------------------
+#if defined(SIM_THREADED)
+static void *SimulationThread(void *arg)
+{
+    SetProfileThreadName("sim");
+    pthread_mutex_lock(&simMutex);
+
+    while (true)
+    {
+        while (simRunning && !stepPending) pthread_cond_wait(&simWake, &simMutex);
+        if (!simRunning) break;
+
+        pthread_mutex_unlock(&simMutex);
+        simulationStep();
+        pthread_mutex_lock(&simMutex);
+
+        stepPending = false;
+        pthread_cond_signal(&simDone);
+    }
+
+    pthread_mutex_unlock(&simMutex);
+    return NULL;
+}
+#endif
+
+//----------------------------------------------------------------------------------
+// Simulation Thread Functions Definition
+//----------------------------------------------------------------------------------
+void InitSimulation(void (*step)(void), int snakeCapacity, int fruitCapacity, int markerCapacity)
+{
+    simulationStep = step;
+
+    for (int i = 0; i < 3; i++)
+    {
+        packets[i] = (RenderPacket){ 0 };
+        packets[i].segments = RL_CALLOC(snakeCapacity, sizeof(CircleInstance));
+        packets[i].fruits = RL_CALLOC(fruitCapacity, sizeof(PacketFruit));
+        packets[i].markers = RL_CALLOC(markerCapacity, sizeof(Vector2));
+    }
+    packetWriting = 0;
+    packetReading = 1;
+    packetShared = 2;
+    packetReceived = false;
+
+#if defined(SIM_THREADED)
+    simRunning = true;
+    if (pthread_create(&simThread, NULL, SimulationThread, NULL) != 0)
+    {
+        TraceLog(LOG_WARNING, "SIM: Failed to start simulation thread, stepping on the main thread");
+        simRunning = false;
+    }
+#endif
+}
+
+void UnloadSimulation(void)
+{
+#if defined(SIM_THREADED)
+    if (simRunning)
+    {
+        pthread_mutex_lock(&simMutex);
+        while (stepPending) pthread_cond_wait(&simDone, &simMutex);
+        simRunning = false;
+        pthread_cond_signal(&simWake);
+        pthread_mutex_unlock(&simMutex);
+        pthread_join(simThread, NULL);
+    }
+#endif
+
+    for (int i = 0; i < 3; i++)
+    {
+        RL_FREE(packets[i].segments);
+        RL_FREE(packets[i].fruits);
+        RL_FREE(packets[i].markers);
+        packets[i] = (RenderPacket){ 0 };
+    }
+}
+
+void RunSimulation(void)
+{
+#if defined(SIM_THREADED)
+    if (simRunning)
+    {
+        pthread_mutex_lock(&simMutex);
+        stepPending = true;
+        pthread_cond_signal(&simWake);
+        pthread_mutex_unlock(&simMutex);
+        return;
+    }
+#endif
+
+    simulationStep();
+}
+
+void WaitForSimulation(void)
+{
+#if defined(SIM_THREADED)
+    if (!simRunning) return;
+
+    PROFILE_BEGIN("WaitForSimulation");
+    pthread_mutex_lock(&simMutex);
+    while (stepPending) pthread_cond_wait(&simDone, &simMutex);
+    pthread_mutex_unlock(&simMutex);
+    PROFILE_END();
+#endif
+}
+
+RenderPacket *BeginRenderPacket(void)
+{
+    return &packets[packetWriting];
+}
+
+void PublishRenderPacket(void)
+{
+    // Release so the packet contents are visible before the index, the previous shared slot comes back
+    packetWriting = __atomic_exchange_n(&packetShared, packetWriting | PACKET_FRESH, __ATOMIC_ACQ_REL) & ~PACKET_FRESH;
+}
+
+const RenderPacket *AcquireRenderPacket(void)
+{
+    if (__atomic_load_n(&packetShared, __ATOMIC_RELAXED) & PACKET_FRESH)
+    {
+        packetReading = __atomic_exchange_n(&packetShared, packetReading, __ATOMIC_ACQ_REL) & ~PACKET_FRESH;
+        packetReceived = true;
+    }
+
+    return GetRenderPacket();
+}
+
+const RenderPacket *GetRenderPacket(void)
+{
+    return packetReceived ? &packets[packetReading] : NULL;
+}
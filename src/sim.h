@@ -0,0 +1,50 @@
+#ifndef SIM_H
+#define SIM_H
+
+#include <stddef.h>
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+typedef struct PacketFruit {
+    Vector2 position;
+    int sprite;
+    float scale;
+} PacketFruit;
+
+// Everything drawn for one simulation state, written by the simulation and never touched again
+// until the render side has moved on to a newer one
+typedef struct RenderPacket {
+    unsigned int tick;                  // Simulation ticks run when it was built
+    Camera2D camera;
+    int segmentCount;
+    CircleInstance *segments;           // Head first, snakeCapacity of them
+    int fruitCount;
+    PacketFruit *fruits;                // Active fruit around the view
+    int markerCount;
+    Vector2 *markers;                   // Active fruit for the minimap
+    Vector2 head;
+    Color headColor;
+    int score;
+    float boost;
+    bool paused;
+    bool gameOver;
+    size_t simArenaPeak;                // High-water of the simulation arena, for the debug overlay
+} RenderPacket;
+
+//----------------------------------------------------------------------------------
+// Simulation Thread Functions Declaration
+//----------------------------------------------------------------------------------
+// The simulation runs step() on its own thread while the main thread keeps the window, input
+// and GL context. Between WaitForSimulation() and the next RunSimulation() the main thread owns
+// all simulation state, packets go through a triple buffer so neither side waits for the other
+void InitSimulation(void (*step)(void), int snakeCapacity, int fruitCapacity, int markerCapacity);
+void UnloadSimulation(void);
+void RunSimulation(void);                       // Starts step(), runs it right away without threads
+void WaitForSimulation(void);                   // Blocks until the last step() returned
+
+RenderPacket *BeginRenderPacket(void);          // Simulation side, packet to fill
+void PublishRenderPacket(void);
+const RenderPacket *AcquireRenderPacket(void);  // Render side, newest published packet, NULL before the first
+const RenderPacket *GetRenderPacket(void);      // Render side, packet taken by the last AcquireRenderPacket()
+
+#endif
@@ -3,6 +3,18 @@
 #include <stdbool.h>
 #include <stdlib.h>
 #include "mapObjects.h"
+#include "circles.h"
+#include "sim.h"
+#include "arena.h"
+#include "tubes.h"
+#include "tuning.h"
+#include "metrics.h"
+
+//----------------------------------------------------------------------------------
+// Some Defines
+//----------------------------------------------------------------------------------
+#define SNAKE_LOD_RADIUS    6.0f        // On screen radius below which segments get skipped
+#define SNAKE_LOD_MAX_STEP  4           // Segments are a few pixels apart, skipping more leaves gaps
 
 //----------------------------------------------------------------------------------
 // Module Variables Definition (global)
@@ -15,6 +27,7 @@ int counterTail = 0;
 // Module Variables Definition (local)
 //----------------------------------------------------------------------------------
 static Vector2 snakePosition[SNAKE_LENGTH] = { 0 };
+static bool snakeAsTube = false;       // Draw the body as one joined tube instead of circles
 static Color SnakeColorPatern1[] = { ORANGE, SKYBLUE, MAGENTA, LIME, YELLOW };
 //Aceleration
 static Vector2 currentSpeed = { 0 };
@@ -42,6 +55,11 @@ static float sinAngleNegative = 0;
 //----------------------------------------------------------------------------------
 void InitSnake(void)
 {
+    // Read at the start of every round
+    TuneFloat("snakeSizeRadius", &snakeSizeRadius);
+    TuneInt("snakeSpeed", &snakeSpeed);
+    TuneInt("tailStartSize", &tailStartSize);
+
     //Needed for keyboard movement
     cosAnglePositive = cosf(turnAngle * DEG2RAD);
     sinAnglePositive = sinf(turnAngle * DEG2RAD);
@@ -72,7 +90,7 @@ void SetSnakeAsCameraTarget(Camera2D *camera)
     camera->target = snake->position;
 }
 
-void UpdateMovement(Camera2D *camera)
+void UpdateMovement(Camera2D *camera, SimInput input)
 {   
     // mousePos = GetMousePosition();
 
@@ -101,21 +119,21 @@ void UpdateMovement(Camera2D *camera)
     if (!accelerating) currentSpeed = snake->speed;
 
         /*Keyboard controlls*/
-    if (IsKeyDown(KEY_RIGHT) && IsKeyUp(KEY_LEFT) && !accelerating)
+    if (input.right && !input.left && !accelerating)
     {
         snake->speed = (Vector2){snake->speed.x * cosAnglePositive - snake->speed.y * sinAnglePositive, snake->speed.x * sinAnglePositive + snake->speed.y * cosAnglePositive};
     }
-    else if (IsKeyDown(KEY_LEFT) && IsKeyUp(KEY_RIGHT) && !accelerating)
+    else if (input.left && !input.right && !accelerating)
     {
         snake->speed = (Vector2){snake->speed.x * cosAngleNegative - snake->speed.y * sinAngleNegative, snake->speed.x * sinAngleNegative + snake->speed.y * cosAngleNegative};
     }
 
     //Camera zoom
-    if (IsKeyDown(KEY_Q)) camera->zoom += .01f;
-    if (IsKeyDown(KEY_E)) camera->zoom -= .01f;
+    if (input.zoomIn) camera->zoom *= 1.02f;
+    if (input.zoomOut) camera->zoom /= 1.02f;
     
     //Acceleration
-    if (IsKeyDown(KEY_SPACE))
+    if (input.boost)
     {
         // if (snake->boostCapacity > 0)
         // {
@@ -132,7 +150,7 @@ void UpdateMovement(Camera2D *camera)
         snake->speed = (Vector2){currentSpeed.x * 8.0f, currentSpeed.y * 8.0f};
     }
 
-    if (IsKeyReleased(KEY_SPACE))
+    if (input.boostReleased)
     {
         accelerating = false;
         snake->speed = currentSpeed;
@@ -170,9 +188,42 @@ void MoveSnake(void)
     }
 }
 
-void DrawSnake()
+void DrawSnake(Camera2D camera)
 {
-    for (int i = counterTail - 1; i > 0; i--) DrawCircleV(snake[i].position, snake[i].size, snake[i].color);
+    const RenderPacket *packet = GetRenderPacket();
+
+    if (packet->segmentCount <= 0) return;
+
+    // Segments grow with the tail, all of them share the head's radius
+    float radius = packet->segments[0].radius;
+
+    // Segments overlap a lot, when they are only a few pixels wide every other one is enough
+    int step = 1;
+    float screenRadius = radius * camera.zoom;
+    if (screenRadius < SNAKE_LOD_RADIUS) step = MIN((int)(SNAKE_LOD_RADIUS / screenRadius), SNAKE_LOD_MAX_STEP);
+
+    Rectangle view = GetCameraWorldRect(camera);
+    view = (Rectangle){ view.x - radius, view.y - radius, view.width + radius * 2, view.height + radius * 2 };
+
+    CircleInstance *snakeCircles = (CircleInstance *)ArenaAlloc(&frameArena, packet->segmentCount * sizeof(CircleInstance));
+    if (snakeCircles == NULL) return;
+
+    // Tail first so the segments closer to the head stay on top
+    int count = 0;
+    for (int i = packet->segmentCount - 1; i > 0; i -= step)
+    {
+        // A tube would join the points around a culled stretch with a straight capsule
+        if (!snakeAsTube && !CheckCollisionPointRec(packet->segments[i].position, view)) continue;
+        snakeCircles[count++] = packet->segments[i];
+    }
+
+    if (snakeAsTube && DrawTrailTube(snakeCircles, count)) return;
+    DrawCircleInstances(snakeCircles, count);
+}
+
+void ToggleSnakeTube(void)
+{
+    snakeAsTube = !snakeAsTube;
 }
 
 bool FruitIsOnSnake(Food fruit)
@@ -186,8 +237,21 @@ bool FruitIsOnSnake(Food fruit)
 
 void CalcFruitCollision(void)
 {
-    for (int i = 0; i < FOOD_ITEMS; i++)
+    // Candidates from the fruit grid around the head, the margin covers the biggest fruit
+    size_t mark = GetArenaMark(&simArena);
+    int *candidates = (int *)ArenaAlloc(&simArena, foodCount * sizeof(int));
+    int candidateCount = foodCount;     // No room for the list: check every fruit rather than none
+
+    if (candidates != NULL)
     {
+        Rectangle reach = { snake->position.x - snake->size - 64, snake->position.y - snake->size - 64, (snake->size + 64) * 2, (snake->size + 64) * 2 };
+        candidateCount = QueryFruitsInArea(reach, candidates, foodCount);
+    }
+
+    for (int c = 0; c < candidateCount; c++)
+    {
+        int i = (candidates != NULL) ? candidates[c] : c;
+        if (!fruits[i].active) continue;
         if (CheckCollisionCircles(snake->position, snake->size, fruits[i].position, 32 * fruits[i].scale))
         {
 
@@ -209,6 +273,7 @@ void CalcFruitCollision(void)
             counterTail += fruits[i].tailIncreaseSize;
             score += fruits[i].points;
             fruits[i].active = false;
+            CountMetric(METRIC_FRUIT_PICKUPS);
 
             //Increase circle size
             for (int i = 0; i < SNAKE_LENGTH; i++)
@@ -231,4 +296,6 @@ void CalcFruitCollision(void)
             sinAngleNegative = sinf(-turnAngle * DEG2RAD);
         }
     }
+
+    ResetArenaToMark(&simArena, mark);
 }
@@ -0,0 +1,72 @@
+#include "include/raylib.h"
+#include "include/rlgl.h"
+#include "stats.h"
+#include <stddef.h>
+
+//----------------------------------------------------------------------------------
+// Module Variables Definition (local)
+//----------------------------------------------------------------------------------
+// rlgl doesn't expose counters for its internal batch, so we draw through our own
+// batch and read its draw list before every flush we trigger.
+// NOTE: Flushes rlgl does on its own (buffer or draw list full) are not counted
+static rlRenderBatch countedBatch = { 0 };
+static RenderStats frameStats = { 0 };
+static RenderStats lastFrameStats = { 0 };
+
+//----------------------------------------------------------------------------------
+// Render Stats Functions Definition
+//----------------------------------------------------------------------------------
+void InitRenderStats(void)
+{
+    countedBatch = rlLoadRenderBatch(1, 8192);
+    rlSetRenderBatchActive(&countedBatch);
+}
+
+void UnloadRenderStats(void)
+{
+    rlSetRenderBatchActive(NULL);
+    rlUnloadRenderBatch(countedBatch);
+    countedBatch = (rlRenderBatch){ 0 };
+}
+
+void BeginRenderStatsFrame(void)
+{
+    frameStats = (RenderStats){ 0 };
+}
+
+void EndRenderStatsFrame(void)
+{
+    lastFrameStats = frameStats;
+}
+
+void FlushRenderBatch(void)
+{
+    if (countedBatch.draws != NULL)
+    {
+        int drawCalls = 0;
+
+        for (int i = 0; i < countedBatch.drawCounter; i++)
+        {
+            if (countedBatch.draws[i].vertexCount <= 0) continue;
+
+            drawCalls++;
+            frameStats.vertices += countedBatch.draws[i].vertexCount;
+        }
+
+        frameStats.drawCalls += drawCalls;
+        if (drawCalls > 0) frameStats.batches++;
+    }
+
+    rlDrawRenderBatchActive();
+}
+
+void CountDrawCall(int vertices)
+{
+    frameStats.drawCalls++;
+    frameStats.vertices += vertices;
+}
+
+RenderStats GetRenderStats(void)
+{
+    return lastFrameStats;
+}
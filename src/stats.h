@@ -0,0 +1,23 @@
+#ifndef STATS_H
+#define STATS_H
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+typedef struct RenderStats {
+    int drawCalls;          // GPU draw calls submitted by rlgl
+    int vertices;
+    int batches;            // Render batch flushes that drew something
+} RenderStats;
+
+//----------------------------------------------------------------------------------
+// Render Stats Functions Declaration
+//----------------------------------------------------------------------------------
+void InitRenderStats(void);         // Call after InitWindow(), installs the counted render batch
+void UnloadRenderStats(void);
+void BeginRenderStatsFrame(void);
+void EndRenderStatsFrame(void);
+void FlushRenderBatch(void);        // Count and draw everything queued so far, use right before raylib would flush
+void CountDrawCall(int vertices);   // Draws issued outside the render batch (e.g. instancing)
+RenderStats GetRenderStats(void);   // Totals of the last completed frame
+
+#endif
@@ -0,0 +1,280 @@
+#include "include/raylib.h"
+#include "mapObjects.h"
+#include "tilemap.h"
+#include "terrain.h"
+#include "profile.h"
+#define MEM_TAG MEM_TERRAIN
+#include "memtrack.h"
+#include <stdlib.h>
+#include <string.h>
+
+#if !defined(PLATFORM_WEB)
+    #include <pthread.h>
+    #define TERRAIN_THREADED        // Chunks are copied in by a background loader thread
+#endif
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+typedef enum ChunkSlotState { SLOT_FREE = 0, SLOT_LOADING, SLOT_RESIDENT } ChunkSlotState;
+
+//----------------------------------------------------------------------------------
+// Module Variables Definition (local)
+//----------------------------------------------------------------------------------
+static const TileMap *source = NULL;
+static void *poolAllocation = NULL;
+static unsigned char *pool = NULL;                  // TERRAIN_POOL_CHUNKS * CHUNK_BYTES, cache aligned
+static short *chunkSlots = NULL;                    // Slot of every map chunk, -1 if not requested
+static int slotChunk[TERRAIN_POOL_CHUNKS] = { 0 };
+static unsigned char slotState[TERRAIN_POOL_CHUNKS] = { 0 };
+static unsigned int slotLastWanted[TERRAIN_POOL_CHUNKS] = { 0 };
+static unsigned int streamingStamp = 0;
+static int residentChunks = 0;
+
+// Loader queues, protected by loaderMutex when threaded
+static int jobQueue[TERRAIN_POOL_CHUNKS] = { 0 };
+static int jobHead = 0;
+static int jobCount = 0;
+static int doneQueue[TERRAIN_POOL_CHUNKS] = { 0 };
+static int doneCount = 0;
+static int loadsInFlight = 0;
+
+#if defined(TERRAIN_THREADED)
+static pthread_t loaderThread;
+static pthread_mutex_t loaderMutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t loaderWake = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t loaderDone = PTHREAD_COND_INITIALIZER;
+static bool loaderRunning = false;
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition (local)
+//----------------------------------------------------------------------------------
+#if defined(TERRAIN_THREADED)
+static void *LoaderThread(void *arg)
+{
+    SetProfileThreadName("terrain");
+    pthread_mutex_lock(&loaderMutex);
+
+    while (true)
+    {
+        while (loaderRunning && (jobCount == 0)) pthread_cond_wait(&loaderWake, &loaderMutex);
+        if (!loaderRunning) break;
+
+        int slot = jobQueue[jobHead];
+        jobHead = (jobHead + 1) % TERRAIN_POOL_CHUNKS;
+        jobCount--;
+        int chunk = slotChunk[slot];
+
+        // Copying pages the chunk in from the mapped file, keep it off the main thread
+        pthread_mutex_unlock(&loaderMutex);
+        PROFILE_BEGIN("ReadTileMapChunk");
+        ReadTileMapChunk(source, chunk, pool + slot * CHUNK_BYTES);
+        PROFILE_END();
+        pthread_mutex_lock(&loaderMutex);
+
+        doneQueue[doneCount++] = slot;
+        loadsInFlight--;
+        pthread_cond_broadcast(&loaderDone);
+    }
+
+    pthread_mutex_unlock(&loaderMutex);
+
+    return NULL;
+}
+#endif
+
+static void RequestChunkLoad(int slot)
+{
+#if defined(TERRAIN_THREADED)
+    if (loaderRunning)
+    {
+        pthread_mutex_lock(&loaderMutex);
+        jobQueue[(jobHead + jobCount) % TERRAIN_POOL_CHUNKS] = slot;
+        jobCount++;
+        loadsInFlight++;
+        pthread_cond_signal(&loaderWake);
+        pthread_mutex_unlock(&loaderMutex);
+        return;
+    }
+#endif
+    ReadTileMapChunk(source, slotChunk[slot], pool + slot * CHUNK_BYTES);
+    doneQueue[doneCount++] = slot;
+}
+
+// Publish chunks the loader has finished
+static void DrainCompletedLoads(void)
+{
+#if defined(TERRAIN_THREADED)
+    pthread_mutex_lock(&loaderMutex);
+#endif
+    for (int i = 0; i < doneCount; i++)
+    {
+        slotState[doneQueue[i]] = SLOT_RESIDENT;
+        residentChunks++;
+    }
+    doneCount = 0;
+#if defined(TERRAIN_THREADED)
+    pthread_mutex_unlock(&loaderMutex);
+#endif
+}
+
+// Find a free slot or evict the resident chunk that was wanted least recently
+static int AcquireSlot(void)
+{
+    int victim = -1;
+
+    for (int i = 0; i < TERRAIN_POOL_CHUNKS; i++)
+    {
+        if (slotState[i] == SLOT_FREE) return i;
+        if ((slotState[i] == SLOT_RESIDENT) && (slotLastWanted[i] != streamingStamp) &&
+            ((victim < 0) || (slotLastWanted[i] < slotLastWanted[victim]))) victim = i;
+    }
+
+    if (victim >= 0)
+    {
+        chunkSlots[slotChunk[victim]] = -1;
+        slotState[victim] = SLOT_FREE;
+        residentChunks--;
+    }
+
+    return victim;
+}
+
+//----------------------------------------------------------------------------------
+// Terrain Streaming Functions Definition
+//----------------------------------------------------------------------------------
+void InitTerrain(const TileMap *map)
+{
+    UnloadTerrain();
+
+    source = map;
+
+    int chunkCount = map->chunksX * map->chunksY;
+    chunkSlots = (short *)RL_MALLOC(chunkCount * sizeof(short));
+    for (int i = 0; i < chunkCount; i++) chunkSlots[i] = -1;
+
+    // One contiguous allocation for every slot, aligned to a cache line
+    poolAllocation = RL_MALLOC(TERRAIN_POOL_CHUNKS * CHUNK_BYTES + TMAP_DATA_ALIGN);
+    pool = (unsigned char *)(((size_t)poolAllocation + TMAP_DATA_ALIGN - 1) & ~(size_t)(TMAP_DATA_ALIGN - 1));
+
+    memset(slotState, SLOT_FREE, sizeof(slotState));
+    memset(slotLastWanted, 0, sizeof(slotLastWanted));
+    streamingStamp = 0;
+    residentChunks = 0;
+    jobHead = jobCount = doneCount = loadsInFlight = 0;
+
+#if defined(TERRAIN_THREADED)
+    loaderRunning = true;
+    if (pthread_create(&loaderThread, NULL, LoaderThread, NULL) != 0)
+    {
+        TraceLog(LOG_ERROR, "TERRAIN: Failed to start chunk loader thread");
+        loaderRunning = false;
+    }
+#endif
+}
+
+void UnloadTerrain(void)
+{
+    if (source == NULL) return;
+
+#if defined(TERRAIN_THREADED)
+    if (loaderRunning)
+    {
+        pthread_mutex_lock(&loaderMutex);
+        loaderRunning = false;
+        pthread_cond_signal(&loaderWake);
+        pthread_mutex_unlock(&loaderMutex);
+        pthread_join(loaderThread, NULL);
+    }
+#endif
+
+    RL_FREE(chunkSlots);
+    RL_FREE(poolAllocation);
+    chunkSlots = NULL;
+    poolAllocation = NULL;
+    pool = NULL;
+    source = NULL;
+}
+
+// Request every chunk within radius of any focus point, evicting chunks nobody needs anymore
+void UpdateTerrainStreaming(const Vector2 *focus, int focusCount, float radius)
+{
+    if (source == NULL) return;
+
+    DrainCompletedLoads();
+    streamingStamp++;
+
+    for (int f = 0; f < focusCount; f++)
+    {
+        int minX = MAX((int)(focus[f].x - radius) >> CHUNK_SHIFT, 0);
+        int minY = MAX((int)(focus[f].y - radius) >> CHUNK_SHIFT, 0);
+        int maxX = MIN((int)(focus[f].x + radius) >> CHUNK_SHIFT, source->chunksX - 1);
+        int maxY = MIN((int)(focus[f].y + radius) >> CHUNK_SHIFT, source->chunksY - 1);
+
+        for (int cy = minY; cy <= maxY; cy++)
+        {
+            for (int cx = minX; cx <= maxX; cx++)
+            {
+                int chunk = cy * source->chunksX + cx;
+
+                // Uniform chunks are answered straight from the chunk table
+                if (source->chunkTable[chunk] & TMAP_CHUNK_UNIFORM) continue;
+
+                int slot = chunkSlots[chunk];
+                if (slot < 0)
+                {
+                    slot = AcquireSlot();
+                    if (slot < 0) continue;     // Every slot is wanted or loading, retry next update
+
+                    slotChunk[slot] = chunk;
+                    slotState[slot] = SLOT_LOADING;
+                    chunkSlots[chunk] = slot;
+                    RequestChunkLoad(slot);
+                }
+
+                slotLastWanted[slot] = streamingStamp;
+            }
+        }
+    }
+}
+
+void FlushTerrainStreaming(void)
+{
+#if defined(TERRAIN_THREADED)
+    pthread_mutex_lock(&loaderMutex);
+    while (loaderRunning && (loadsInFlight > 0)) pthread_cond_wait(&loaderDone, &loaderMutex);
+    pthread_mutex_unlock(&loaderMutex);
+#endif
+    DrainCompletedLoads();
+}
+
+unsigned char GetTerrainTile(int x, int y)
+{
+    if ((source == NULL) || (x < 0) || (y < 0) || (x >= source->width) || (y >= source->height)) return WATER;
+
+    int chunk = (y >> CHUNK_SHIFT) * source->chunksX + (x >> CHUNK_SHIFT);
+    unsigned int entry = source->chunkTable[chunk];
+    if (entry & TMAP_CHUNK_UNIFORM) return entry & 0xFF;
+
+    int slot = chunkSlots[chunk];
+    if ((slot < 0) || (slotState[slot] != SLOT_RESIDENT)) return WATER;
+
+    return pool[slot * CHUNK_BYTES + GetChunkTileOffset(x & CHUNK_MASK, y & CHUNK_MASK)];
+}
+
+bool IsTerrainTileResident(int x, int y)
+{
+    if ((source == NULL) || (x < 0) || (y < 0) || (x >= source->width) || (y >= source->height)) return true;
+
+    int chunk = (y >> CHUNK_SHIFT) * source->chunksX + (x >> CHUNK_SHIFT);
+    if (source->chunkTable[chunk] & TMAP_CHUNK_UNIFORM) return true;
+
+    int slot = chunkSlots[chunk];
+    return (slot >= 0) && (slotState[slot] == SLOT_RESIDENT);
+}
+
+int GetTerrainResidentChunks(void)
+{
+    return residentChunks;
+}
@@ -0,0 +1,19 @@
+#ifndef TERRAIN_H
+#define TERRAIN_H
+//----------------------------------------------------------------------------------
+// Some Defines
+//----------------------------------------------------------------------------------
+#define TERRAIN_POOL_CHUNKS     64      // Resident chunk slots (CHUNK_BYTES each)
+
+//----------------------------------------------------------------------------------
+// Terrain Streaming Functions Declaration
+//----------------------------------------------------------------------------------
+void InitTerrain(const TileMap *map);       // Map must stay loaded until UnloadTerrain()
+void UnloadTerrain(void);
+void UpdateTerrainStreaming(const Vector2 *focus, int focusCount, float radius);    // Focus points and radius in tiles
+void FlushTerrainStreaming(void);           // Wait for every requested chunk to become resident
+unsigned char GetTerrainTile(int x, int y); // WATER while the chunk is still streaming in
+bool IsTerrainTileResident(int x, int y);   // False while GetTerrainTile() would return the placeholder
+int GetTerrainResidentChunks(void);
+
+#endif
@@ -0,0 +1,224 @@
+#include "include/raylib.h"
+#include "mapObjects.h"
+#include "tilemap.h"
+#define MEM_TAG MEM_MAP
+#include "memtrack.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if !defined(_WIN32) && !defined(PLATFORM_WEB)
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+    #define TMAP_USE_MMAP
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition (local)
+//----------------------------------------------------------------------------------
+static int ChunksPerSide(int tiles)
+{
+    return (tiles + CHUNK_MASK) >> CHUNK_SHIFT;
+}
+
+static size_t AlignOffset(size_t offset)
+{
+    return (offset + TMAP_DATA_ALIGN - 1) & ~(size_t)(TMAP_DATA_ALIGN - 1);
+}
+
+static bool IsValidHeader(const TileMapHeader *header, size_t fileSize)
+{
+    size_t chunkCount = (size_t)ChunksPerSide(header->width) * ChunksPerSide(header->height);
+
+    return (memcmp(header->magic, "TMAP", 4) == 0) &&
+           (header->version == TMAP_VERSION) &&
+           (header->bitsPerTile == 8) &&
+           (header->chunkSize == CHUNK_SIZE) &&
+           (header->tableOffset % TMAP_DATA_ALIGN == 0) &&
+           (header->dataOffset % TMAP_DATA_ALIGN == 0) &&
+           (header->tableOffset + chunkCount * sizeof(unsigned int) <= header->dataOffset) &&
+           (header->dataOffset + (size_t)header->storedChunks * CHUNK_BYTES <= fileSize);
+}
+
+// Point the map fields at the table and chunk data of a .tmap image
+static void SetTileMapLayout(TileMap *map)
+{
+    const TileMapHeader *header = (const TileMapHeader *)map->data;
+
+    map->width = header->width;
+    map->height = header->height;
+    map->chunksX = ChunksPerSide(header->width);
+    map->chunksY = ChunksPerSide(header->height);
+    map->storedChunks = header->storedChunks;
+    map->chunkTable = (const unsigned int *)((const unsigned char *)map->data + header->tableOffset);
+    map->chunkData = (const unsigned char *)map->data + header->dataOffset;
+}
+
+//----------------------------------------------------------------------------------
+// Tile Map Functions Definition
+//----------------------------------------------------------------------------------
+// Classify one BWMap.png pixel into a paletteName
+unsigned char ClassifyTileColor(Color color)
+{
+    unsigned char tile = WATER;
+
+    if (color.b >= 220 && color.r <= 220 && color.g <= 220) tile = WATER;
+
+    if (color.r <= 10) tile = SAND;
+    else if (color.r <= 50) tile = DIRT;
+    else if (color.r <= 90) tile = GRASS1;
+    else if (color.r <= 130) tile = GRASS2;
+    else if (color.r <= 170) tile = GRASS3;
+    else tile = ROCK;
+
+    return tile;
+}
+
+// Classify map image pixels (row-major) into an in-memory .tmap image,
+// chunks made of a single tile are only stored in the chunk table
+TileMap AssignColors(const Color *colors, int width, int height)
+{
+    TileMap map = { 0 };
+    int chunksX = ChunksPerSide(width);
+    int chunksY = ChunksPerSide(height);
+    size_t tableOffset = TMAP_DATA_ALIGN;
+    size_t dataOffset = AlignOffset(tableOffset + (size_t)chunksX * chunksY * sizeof(unsigned int));
+
+    unsigned char *data = (unsigned char *)RL_CALLOC(dataOffset + (size_t)chunksX * chunksY * CHUNK_BYTES, 1);
+    unsigned int *table = (unsigned int *)(data + tableOffset);
+    unsigned int stored = 0;
+
+    for (int cy = 0; cy < chunksY; cy++)
+    {
+        for (int cx = 0; cx < chunksX; cx++)
+        {
+            unsigned char *chunk = data + dataOffset + (size_t)stored * CHUNK_BYTES;
+            unsigned char first = ClassifyTileColor(colors[(cy << CHUNK_SHIFT) * width + (cx << CHUNK_SHIFT)]);
+            bool uniform = true;
+
+            for (int y = 0; y < CHUNK_SIZE; y++)
+            {
+                for (int x = 0; x < CHUNK_SIZE; x++)
+                {
+                    int tileX = (cx << CHUNK_SHIFT) + x;
+                    int tileY = (cy << CHUNK_SHIFT) + y;
+
+                    // Padding past the map edge repeats the first tile so it can't break uniformity
+                    unsigned char tile = first;
+                    if (tileX < width && tileY < height) tile = ClassifyTileColor(colors[tileY * width + tileX]);
+
+                    chunk[GetChunkTileOffset(x, y)] = tile;
+                    if (tile != first) uniform = false;
+                }
+            }
+
+            if (uniform)
+            {
+                table[cy * chunksX + cx] = TMAP_CHUNK_UNIFORM | first;
+                memset(chunk, 0, CHUNK_BYTES);
+            }
+            else table[cy * chunksX + cx] = stored++;
+        }
+    }
+
+    TileMapHeader *header = (TileMapHeader *)data;
+    memcpy(header->magic, "TMAP", 4);
+    header->version = TMAP_VERSION;
+    header->bitsPerTile = 8;
+    header->width = width;
+    header->height = height;
+    header->chunkSize = CHUNK_SIZE;
+    header->tableOffset = tableOffset;
+    header->dataOffset = dataOffset;
+    header->storedChunks = stored;
+
+    map.dataSize = dataOffset + (size_t)stored * CHUNK_BYTES;
+    map.data = RL_REALLOC(data, map.dataSize);
+    SetTileMapLayout(&map);
+
+    return map;
+}
+
+// Map a .tmap file into memory, returns a map with data == NULL on failure
+TileMap LoadTileMap(const char *fileName)
+{
+    TileMap map = { 0 };
+
+#if defined(TMAP_USE_MMAP)
+    int fd = open(fileName, O_RDONLY);
+    if (fd < 0) return map;
+
+    struct stat st;
+    if (fstat(fd, &st) == 0 && st.st_size >= (off_t)sizeof(TileMapHeader))
+    {
+        void *data = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data != MAP_FAILED)
+        {
+            map.data = data;
+            map.dataSize = (size_t)st.st_size;
+        }
+    }
+    close(fd);      // The mapping stays valid after closing the descriptor
+#else
+    unsigned int bytesRead = 0;
+    map.data = LoadFileData(fileName, &bytesRead);
+    map.dataSize = bytesRead;
+#endif
+    map.fromFile = true;
+
+    if (map.data == NULL) return map;
+
+    if ((map.dataSize < sizeof(TileMapHeader)) || !IsValidHeader((const TileMapHeader *)map.data, map.dataSize))
+    {
+        TraceLog(LOG_WARNING, "TMAP: [%s] Invalid or outdated tile map file", fileName);
+        UnloadTileMap(map);
+        return (TileMap){ 0 };
+    }
+
+    SetTileMapLayout(&map);
+
+    TraceLog(LOG_INFO, "TMAP: [%s] Tile map loaded successfully (%ix%i, %i/%i chunks stored)",
+             fileName, map.width, map.height, map.storedChunks, map.chunksX * map.chunksY);
+
+    return map;
+}
+
+void UnloadTileMap(TileMap map)
+{
+    if (map.data == NULL) return;
+
+    if (map.fromFile)
+    {
+#if defined(TMAP_USE_MMAP)
+        munmap(map.data, map.dataSize);
+#else
+        UnloadFileData(map.data);
+#endif
+    }
+    else RL_FREE(map.data);
+}
+
+// Write a tile map as a .tmap file, the in-memory image already has the on-disk layout
+bool ExportTileMap(const char *fileName, TileMap map)
+{
+    FILE *file = fopen(fileName, "wb");
+    if (file == NULL) return false;
+
+    bool success = (fwrite(map.data, 1, map.dataSize, file) == map.dataSize);
+
+    fclose(file);
+
+    return success;
+}
+
+// Copy chunk tiles (CHUNK_BYTES, blocked layout) into tiles, expanding uniform chunks
+void ReadTileMapChunk(const TileMap *map, int chunk, unsigned char *tiles)
+{
+    unsigned int entry = map->chunkTable[chunk];
+
+    if (entry & TMAP_CHUNK_UNIFORM) memset(tiles, entry & 0xFF, CHUNK_BYTES);
+    else if (entry < (unsigned int)map->storedChunks) memcpy(tiles, map->chunkData + (size_t)entry * CHUNK_BYTES, CHUNK_BYTES);
+    else memset(tiles, WATER, CHUNK_BYTES);
+}
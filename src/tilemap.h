@@ -0,0 +1,76 @@
+#ifndef TILEMAP_H
+#define TILEMAP_H
+
+#include <stddef.h>
+//----------------------------------------------------------------------------------
+// Some Defines
+//----------------------------------------------------------------------------------
+#define TMAP_VERSION        3
+#define TMAP_DATA_ALIGN     64      // Chunk table/data alignment, one cache line
+
+// Inside a chunk, tiles are stored in square blocks of TILE_BLOCK_SIZE x TILE_BLOCK_SIZE bytes,
+// so one block is exactly one cache line and a small neighborhood touches few lines
+#define TILE_BLOCK_SHIFT    3
+#define TILE_BLOCK_SIZE     (1 << TILE_BLOCK_SHIFT)
+#define TILE_BLOCK_MASK     (TILE_BLOCK_SIZE - 1)
+#define TILE_BLOCK_BYTES    (TILE_BLOCK_SIZE * TILE_BLOCK_SIZE)
+
+// The map is split into CHUNK_SIZE x CHUNK_SIZE tile chunks, the unit of streaming
+#define CHUNK_SHIFT         5
+#define CHUNK_SIZE          (1 << CHUNK_SHIFT)
+#define CHUNK_MASK          (CHUNK_SIZE - 1)
+#define CHUNK_BYTES         (CHUNK_SIZE * CHUNK_SIZE)
+#define CHUNK_BLOCKS_PER_ROW (CHUNK_SIZE >> TILE_BLOCK_SHIFT)
+
+// Chunk table entry flag: the whole chunk is one tile (stored in the low byte) and has no data
+#define TMAP_CHUNK_UNIFORM  0x80000000u
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+// On-disk header of a packed .tmap file. It is followed by the chunk table
+// (one unsigned int per chunk, row-major) and the stored chunks (CHUNK_BYTES each)
+typedef struct TileMapHeader {
+    char magic[4];                  // "TMAP"
+    unsigned short version;
+    unsigned short bitsPerTile;
+    unsigned int width;             // Map size in tiles
+    unsigned int height;
+    unsigned int chunkSize;
+    unsigned int tableOffset;
+    unsigned int dataOffset;
+    unsigned int storedChunks;
+} TileMapHeader;
+
+// Chunked tile map source, either a mapped .tmap file or the same layout built in memory
+typedef struct TileMap {
+    int width;                      // Map size in tiles
+    int height;
+    int chunksX;                    // Map size in chunks
+    int chunksY;
+    int storedChunks;
+    const unsigned int *chunkTable;
+    const unsigned char *chunkData;
+    void *data;                     // mmap view of a .tmap file or heap copy of the same layout
+    size_t dataSize;
+    bool fromFile;                  // Backed by LoadTileMap() rather than AssignColors()
+} TileMap;
+
+//----------------------------------------------------------------------------------
+// Tile Map Functions Declaration
+//----------------------------------------------------------------------------------
+unsigned char ClassifyTileColor(Color color);
+TileMap AssignColors(const Color *colors, int width, int height);
+TileMap LoadTileMap(const char *fileName);
+void UnloadTileMap(TileMap map);
+bool ExportTileMap(const char *fileName, TileMap map);
+void ReadTileMapChunk(const TileMap *map, int chunk, unsigned char *tiles);
+
+// Byte offset of local tile (x, y) inside a chunk
+static inline int GetChunkTileOffset(int x, int y)
+{
+    int block = (y >> TILE_BLOCK_SHIFT) * CHUNK_BLOCKS_PER_ROW + (x >> TILE_BLOCK_SHIFT);
+    return block * TILE_BLOCK_BYTES + ((y & TILE_BLOCK_MASK) << TILE_BLOCK_SHIFT) + (x & TILE_BLOCK_MASK);
+}
+
+#endif
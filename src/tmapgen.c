@@ -0,0 +1,40 @@
+/*******************************************************************************************
+*
+*   tmapgen - offline tile map compiler
+*
+*   Decodes the map image once and writes the classified tiles as a packed .tmap file,
+*   so the game doesn't have to decode and classify the PNG on every launch.
+*
+*   Usage: tmapgen <input.png> <output.tmap>
+*
+********************************************************************************************/
+
+#include "include/raylib.h"
+#include "mapObjects.h"
+#include "tilemap.h"
+#include <stdio.h>
+
+int main(int argc, char *argv[])
+{
+    if (argc < 3)
+    {
+        printf("Usage: %s <input.png> <output.tmap>\n", argv[0]);
+        return 1;
+    }
+
+    Image image = LoadImage(argv[1]);
+    if (image.data == NULL) return 1;
+
+    Color *colors = LoadImageColors(image);
+    TileMap map = AssignColors(colors, image.width, image.height);
+
+    bool success = ExportTileMap(argv[2], map);
+    if (success) TraceLog(LOG_INFO, "TMAP: [%s] Tile map exported successfully (%ix%i)", argv[2], image.width, image.height);
+    else TraceLog(LOG_WARNING, "TMAP: [%s] Failed to export tile map", argv[2]);
+
+    UnloadTileMap(map);
+    UnloadImageColors(colors);
+    UnloadImage(image);
+
+    return success ? 0 : 1;
+}
@@ -0,0 +1,160 @@
+#include "include/raylib.h"
+#include "include/rlgl.h"
+#include "circles.h"
+#include "tubes.h"
+#include "stats.h"
+#define MEM_TAG MEM_RENDER
+#include "memtrack.h"
+#include <stddef.h>
+
+// Float textures and texelFetch need GL 3.3, the web build (GLES2) has no tube mode
+#if !defined(PLATFORM_WEB)
+    #define TUBES_SUPPORTED
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Variables Definition (local)
+//----------------------------------------------------------------------------------
+#if defined(TUBES_SUPPORTED)
+#define STRINGIFY(x)    #x
+#define TOSTRING(x)     STRINGIFY(x)
+
+// Quads carry world position as texcoord and their run (first point, capsule count) in the vertex color.
+// The data texture holds x, y, radius per point in row 0 and the point color in row 1.
+static const char *tubeFragmentShader =
+    "#version 330\n"
+    "in vec2 fragTexCoord;\n"
+    "in vec4 fragColor;\n"
+    "uniform sampler2D texture0;\n"
+    "out vec4 finalColor;\n"
+    "void main()\n"
+    "{\n"
+    "    int first = int(fragColor.r*255.0 + 0.5) + int(fragColor.g*255.0 + 0.5)*256;\n"
+    "    int count = int(fragColor.b*255.0 + 0.5);\n"
+    "    float dist = 1e9;\n"
+    "    vec4 color = vec4(0.0);\n"
+    "    for (int i = 0; i < " TOSTRING(TUBE_RUN_SEGMENTS) "; i++)\n"
+    "    {\n"
+    "        if (i >= count) break;\n"
+    "        vec4 a = texelFetch(texture0, ivec2(first + i, 0), 0);\n"
+    "        vec4 b = texelFetch(texture0, ivec2(first + i + 1, 0), 0);\n"
+    "        vec2 pa = fragTexCoord - a.xy;\n"
+    "        vec2 ba = b.xy - a.xy;\n"
+    "        float h = clamp(dot(pa, ba)/max(dot(ba, ba), 1e-4), 0.0, 1.0);\n"
+    "        float d = length(pa - ba*h) - mix(a.z, b.z, h);\n"
+    "        if (d <= dist)\n"
+    "        {\n"
+    "            dist = d;\n"
+    "            color = texelFetch(texture0, ivec2(first + i + int(h > 0.5), 1), 0);\n"
+    "        }\n"
+    "    }\n"
+    "    float alpha = clamp(0.5 - dist/max(fwidth(dist), 1e-4), 0.0, 1.0);\n"
+    "    if (alpha <= 0.0) discard;\n"
+    "    finalColor = vec4(color.rgb, color.a*alpha);\n"
+    "}\n";
+
+static Shader tubeShader = { 0 };
+static unsigned int trailTexture = 0;
+static float trailData[2 * TUBE_MAX_POINTS * 4] = { 0 };
+#endif
+
+//----------------------------------------------------------------------------------
+// Tube Renderer Functions Definition
+//----------------------------------------------------------------------------------
+void InitTubeRenderer(void)
+{
+#if defined(TUBES_SUPPORTED)
+    if (rlGetVersion() < OPENGL_33)
+    {
+        TraceLog(LOG_WARNING, "TUBES: Float textures not supported, tube mode disabled");
+        return;
+    }
+
+    tubeShader = LoadShaderFromMemory(NULL, tubeFragmentShader);
+    trailTexture = rlLoadTexture(NULL, TUBE_MAX_POINTS, 2, RL_PIXELFORMAT_UNCOMPRESSED_R32G32B32A32, 1);
+#endif
+}
+
+void UnloadTubeRenderer(void)
+{
+#if defined(TUBES_SUPPORTED)
+    if (trailTexture != 0) rlUnloadTexture(trailTexture);
+    if (tubeShader.id != 0) UnloadShader(tubeShader);
+
+    trailTexture = 0;
+    tubeShader = (Shader){ 0 };
+#endif
+}
+
+bool DrawTrailTube(const CircleInstance *points, int count)
+{
+#if defined(TUBES_SUPPORTED)
+    if ((trailTexture == 0) || (tubeShader.id == 0) || (count <= 0)) return false;
+
+    if (count > TUBE_MAX_POINTS) count = TUBE_MAX_POINTS;
+
+    // A single point is a zero length capsule
+    int pointCount = (count > 1) ? count : 2;
+    for (int i = 0; i < pointCount; i++)
+    {
+        const CircleInstance *point = &points[(i < count) ? i : count - 1];
+        float *shape = &trailData[i * 4];
+        float *color = &trailData[(pointCount + i) * 4];
+
+        shape[0] = point->position.x;
+        shape[1] = point->position.y;
+        shape[2] = point->radius;
+        shape[3] = 0.0f;
+        color[0] = point->color.r / 255.0f;
+        color[1] = point->color.g / 255.0f;
+        color[2] = point->color.b / 255.0f;
+        color[3] = point->color.a / 255.0f;
+    }
+    rlUpdateTexture(trailTexture, 0, 0, pointCount, 2, RL_PIXELFORMAT_UNCOMPRESSED_R32G32B32A32, trailData);
+
+    // Changing shader flushes the batch, do it through the counted flush
+    FlushRenderBatch();
+    BeginShaderMode(tubeShader);
+    rlSetTexture(trailTexture);
+    rlBegin(RL_QUADS);
+
+    for (int first = 0; first < pointCount - 1; first += TUBE_RUN_SEGMENTS)
+    {
+        int segments = ((pointCount - 1 - first) < TUBE_RUN_SEGMENTS) ? (pointCount - 1 - first) : TUBE_RUN_SEGMENTS;
+
+        // Bounds of every capsule in the run, plus a pixel of antialiasing
+        Rectangle bounds = { trailData[first * 4], trailData[first * 4 + 1], 0, 0 };
+        float maxX = bounds.x, maxY = bounds.y, radius = 0.0f;
+        for (int i = first; i <= first + segments; i++)
+        {
+            const float *shape = &trailData[i * 4];
+            if (shape[0] < bounds.x) bounds.x = shape[0];
+            if (shape[1] < bounds.y) bounds.y = shape[1];
+            if (shape[0] > maxX) maxX = shape[0];
+            if (shape[1] > maxY) maxY = shape[1];
+            if (shape[2] > radius) radius = shape[2];
+        }
+        radius += 2.0f;
+        bounds = (Rectangle){ bounds.x - radius, bounds.y - radius, maxX - bounds.x + radius * 2, maxY - bounds.y + radius * 2 };
+
+        rlColor4ub(first & 0xff, first >> 8, segments, 255);
+        rlTexCoord2f(bounds.x, bounds.y);
+        rlVertex2f(bounds.x, bounds.y);
+        rlTexCoord2f(bounds.x, bounds.y + bounds.height);
+        rlVertex2f(bounds.x, bounds.y + bounds.height);
+        rlTexCoord2f(bounds.x + bounds.width, bounds.y + bounds.height);
+        rlVertex2f(bounds.x + bounds.width, bounds.y + bounds.height);
+        rlTexCoord2f(bounds.x + bounds.width, bounds.y);
+        rlVertex2f(bounds.x + bounds.width, bounds.y);
+    }
+
+    rlEnd();
+    rlSetTexture(0);
+    FlushRenderBatch();
+    EndShaderMode();
+
+    return true;
+#else
+    return false;
+#endif
+}
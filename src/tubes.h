@@ -0,0 +1,17 @@
+#ifndef TUBES_H
+#define TUBES_H
+//----------------------------------------------------------------------------------
+// Some Defines
+//----------------------------------------------------------------------------------
+#define TUBE_MAX_POINTS     1024    // Trail points per tube (data texture width)
+#define TUBE_RUN_SEGMENTS   16      // Capsules evaluated per pixel, one quad covers each run
+
+//----------------------------------------------------------------------------------
+// Tube Renderer Functions Declaration
+//----------------------------------------------------------------------------------
+// Trail points reuse CircleInstance (circles.h): center, radius and color of every joint
+void InitTubeRenderer(void);        // Call after InitWindow(), needs GL 3.3 float textures
+void UnloadTubeRenderer(void);
+bool DrawTrailTube(const CircleInstance *points, int count);    // False if not supported, first point drawn at the bottom
+
+#endif
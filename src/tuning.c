@@ -0,0 +1,156 @@
+#include "include/raylib.h"
+#include "tuning.h"
+#include "watch.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+typedef struct TuningValue {
+    const char *name;
+    float *floatValue;          // One of the two is set
+    int *intValue;
+} TuningValue;
+
+//----------------------------------------------------------------------------------
+// Module Variables Definition (local)
+//----------------------------------------------------------------------------------
+static TuningValue values[TUNING_MAX_VALUES] = { 0 };
+static int valueCount = 0;
+static char tuningFile[512] = { 0 };
+static char *tuningText = NULL;         // Last loaded file contents
+static int tuningWatch = -1;
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition (local)
+//----------------------------------------------------------------------------------
+static TuningValue *FindTuningValue(const char *name, int length)
+{
+    for (int i = 0; i < valueCount; i++)
+    {
+        if ((strncmp(values[i].name, name, length) == 0) && (values[i].name[length] == '\0')) return &values[i];
+    }
+    return NULL;
+}
+
+static void SetTuningValue(TuningValue *value, const char *text)
+{
+    char *end = NULL;
+
+    if (value->floatValue != NULL)
+    {
+        float parsed = strtof(text, &end);
+        if ((end != text) && (parsed != *value->floatValue))
+        {
+            TraceLog(LOG_INFO, "TUNING: [%s] %g -> %g", value->name, *value->floatValue, parsed);
+            *value->floatValue = parsed;
+        }
+    }
+    else
+    {
+        int parsed = (int)strtol(text, &end, 10);
+        if ((end != text) && (parsed != *value->intValue))
+        {
+            TraceLog(LOG_INFO, "TUNING: [%s] %i -> %i", value->name, *value->intValue, parsed);
+            *value->intValue = parsed;
+        }
+    }
+
+    if (end == text) TraceLog(LOG_WARNING, "TUNING: [%s] Value is not a number", value->name);
+}
+
+// Apply every line of the loaded file, or only the one for a newly registered value
+static void ApplyTuningText(const TuningValue *only)
+{
+    if (tuningText == NULL) return;
+
+    for (const char *line = tuningText; *line != '\0'; )
+    {
+        const char *lineEnd = strchr(line, '\n');
+        if (lineEnd == NULL) lineEnd = line + strlen(line);
+
+        const char *name = line + strspn(line, " \t");
+        int nameLength = (int)strcspn(name, " \t=#\r\n");
+        const char *equals = name + nameLength + strspn(name + nameLength, " \t");
+
+        if ((nameLength > 0) && (*equals == '=') && (equals < lineEnd))
+        {
+            TuningValue *value = FindTuningValue(name, nameLength);
+
+            // Parse a copy, so a missing value can't pick up the next line
+            char text[64] = { 0 };
+            snprintf(text, sizeof(text), "%.*s", (int)(lineEnd - equals - 1), equals + 1);
+
+            if ((value != NULL) && ((only == NULL) || (value == only))) SetTuningValue(value, text);
+            else if ((value == NULL) && (only == NULL)) TraceLog(LOG_WARNING, "TUNING: [%.*s] Unknown value", nameLength, name);
+        }
+
+        line = (*lineEnd == '\n') ? lineEnd + 1 : lineEnd;
+    }
+}
+
+static void LoadTuningText(void)
+{
+    if (tuningText != NULL) UnloadFileText(tuningText);
+    tuningText = FileExists(tuningFile) ? LoadFileText(tuningFile) : NULL;
+}
+
+static void RegisterTuningValue(TuningValue value)
+{
+    TuningValue *existing = FindTuningValue(value.name, (int)strlen(value.name));
+
+    if (existing == NULL)
+    {
+        if (valueCount >= TUNING_MAX_VALUES)
+        {
+            TraceLog(LOG_WARNING, "TUNING: [%s] Too many tuning values", value.name);
+            return;
+        }
+        existing = &values[valueCount++];
+    }
+
+    *existing = value;
+    ApplyTuningText(existing);
+}
+
+//----------------------------------------------------------------------------------
+// Tuning Functions Definition
+//----------------------------------------------------------------------------------
+void InitTuning(const char *fileName)
+{
+    snprintf(tuningFile, sizeof(tuningFile), "%s", fileName);
+    tuningWatch = WatchFile(tuningFile);
+    LoadTuningText();
+
+    // Values registered earlier, later ones pick up the file when they register
+    for (int i = 0; i < valueCount; i++) ApplyTuningText(&values[i]);
+}
+
+void UnloadTuning(void)
+{
+    UnwatchFile(tuningWatch);
+    tuningWatch = -1;
+    if (tuningText != NULL) UnloadFileText(tuningText);
+    tuningText = NULL;
+}
+
+void UpdateTuning(void)
+{
+    if (!IsFileChanged(tuningWatch)) return;
+
+    TraceLog(LOG_INFO, "TUNING: [%s] Changed, reloading", tuningFile);
+    LoadTuningText();
+    ApplyTuningText(NULL);
+}
+
+void TuneFloat(const char *name, float *value)
+{
+    RegisterTuningValue((TuningValue){ .name = name, .floatValue = value });
+}
+
+void TuneInt(const char *name, int *value)
+{
+    RegisterTuningValue((TuningValue){ .name = name, .intValue = value });
+}
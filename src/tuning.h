@@ -0,0 +1,21 @@
+#ifndef TUNING_H
+#define TUNING_H
+//----------------------------------------------------------------------------------
+// Some Defines
+//----------------------------------------------------------------------------------
+#define TUNING_MAX_VALUES       64
+
+//----------------------------------------------------------------------------------
+// Tuning Functions Declaration
+//----------------------------------------------------------------------------------
+// Tuning file lines are "name = value", '#' starts a comment. Modules register their statics,
+// values from the file are applied on registration and again whenever the file changes.
+// Missing names keep their compiled-in value.
+void InitTuning(const char *fileName);  // Call after InitFileWatch()
+void UnloadTuning(void);
+void UpdateTuning(void);                // Between ticks, re-reads the file if it changed
+
+void TuneFloat(const char *name, float *value);     // Name string and value must outlive the tuning
+void TuneInt(const char *name, int *value);
+
+#endif
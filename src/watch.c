@@ -0,0 +1,159 @@
+#include "include/raylib.h"
+#include "watch.h"
+#include <stdio.h>
+#include <string.h>
+
+#if defined(__linux__) && !defined(PLATFORM_WEB)
+    #include <sys/inotify.h>
+    #include <unistd.h>
+    #define WATCH_USE_INOTIFY
+#endif
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+typedef struct WatchedFile {
+    bool used;
+    bool changed;
+    char path[512];
+    const char *name;           // File name part of path
+    int wd;                     // inotify watch of the directory, shared by files in it
+    long modTime;
+} WatchedFile;
+
+//----------------------------------------------------------------------------------
+// Module Variables Definition (local)
+//----------------------------------------------------------------------------------
+static WatchedFile watched[WATCH_MAX_FILES] = { 0 };
+static int inotifyFd = -1;
+static double lastPoll = 0.0;
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition (local)
+//----------------------------------------------------------------------------------
+#if defined(WATCH_USE_INOTIFY)
+static void ReadWatchEvents(void)
+{
+    char buffer[4096] __attribute__((aligned(__alignof__(struct inotify_event))));
+    ssize_t length = 0;
+
+    while ((length = read(inotifyFd, buffer, sizeof(buffer))) > 0)
+    {
+        for (char *ptr = buffer; ptr < buffer + length; ptr += sizeof(struct inotify_event) + ((struct inotify_event *)ptr)->len)
+        {
+            const struct inotify_event *event = (const struct inotify_event *)ptr;
+
+            for (int i = 0; i < WATCH_MAX_FILES; i++)
+            {
+                if (!watched[i].used) continue;
+
+                // Events got lost, assume everything changed
+                if (event->mask & IN_Q_OVERFLOW) watched[i].changed = true;
+                else if ((event->wd == watched[i].wd) && (event->len > 0) && (strcmp(event->name, watched[i].name) == 0)) watched[i].changed = true;
+            }
+        }
+    }
+}
+#endif
+
+//----------------------------------------------------------------------------------
+// File Watch Functions Definition
+//----------------------------------------------------------------------------------
+void InitFileWatch(void)
+{
+#if defined(WATCH_USE_INOTIFY)
+    if (inotifyFd >= 0) return;
+
+    inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (inotifyFd < 0) TraceLog(LOG_WARNING, "WATCH: inotify unavailable, polling file modification times");
+#endif
+}
+
+void UnloadFileWatch(void)
+{
+    for (int i = 0; i < WATCH_MAX_FILES; i++) UnwatchFile(i);
+
+#if defined(WATCH_USE_INOTIFY)
+    if (inotifyFd >= 0) close(inotifyFd);
+    inotifyFd = -1;
+#endif
+}
+
+void UpdateFileWatch(void)
+{
+#if defined(WATCH_USE_INOTIFY)
+    if (inotifyFd >= 0)
+    {
+        ReadWatchEvents();
+        return;
+    }
+#endif
+
+    if (GetTime() - lastPoll < WATCH_POLL_INTERVAL) return;
+    lastPoll = GetTime();
+
+    for (int i = 0; i < WATCH_MAX_FILES; i++)
+    {
+        if (!watched[i].used || !FileExists(watched[i].path)) continue;
+
+        long modTime = GetFileModTime(watched[i].path);
+        if (modTime != watched[i].modTime) watched[i].changed = true;
+        watched[i].modTime = modTime;
+    }
+}
+
+int WatchFile(const char *fileName)
+{
+    int watch = -1;
+    for (int i = 0; i < WATCH_MAX_FILES; i++)
+    {
+        if (!watched[i].used)
+        {
+            watch = i;
+            break;
+        }
+    }
+
+    if (watch < 0)
+    {
+        TraceLog(LOG_WARNING, "WATCH: [%s] Watch table full, changes will be missed", fileName);
+        return -1;
+    }
+
+    WatchedFile *file = &watched[watch];
+    *file = (WatchedFile){ .used = true, .wd = -1 };
+    snprintf(file->path, sizeof(file->path), "%s", fileName);
+    file->name = GetFileName(file->path);
+    if (FileExists(file->path)) file->modTime = GetFileModTime(file->path);
+
+#if defined(WATCH_USE_INOTIFY)
+    // Watching the same directory again returns the same descriptor
+    if (inotifyFd >= 0) file->wd = inotify_add_watch(inotifyFd, GetDirectoryPath(file->path), IN_CLOSE_WRITE | IN_MOVED_TO);
+#endif
+
+    return watch;
+}
+
+void UnwatchFile(int watch)
+{
+    if ((watch < 0) || (watch >= WATCH_MAX_FILES) || !watched[watch].used) return;
+
+    int wd = watched[watch].wd;
+    watched[watch] = (WatchedFile){ 0 };
+
+#if defined(WATCH_USE_INOTIFY)
+    if ((inotifyFd < 0) || (wd < 0)) return;
+    for (int i = 0; i < WATCH_MAX_FILES; i++) if (watched[i].used && (watched[i].wd == wd)) return;
+    inotify_rm_watch(inotifyFd, wd);
+#else
+    (void)wd;
+#endif
+}
+
+bool IsFileChanged(int watch)
+{
+    if ((watch < 0) || (watch >= WATCH_MAX_FILES) || !watched[watch].changed) return false;
+
+    watched[watch].changed = false;
+    return true;
+}
@@ -0,0 +1,22 @@
+#ifndef WATCH_H
+#define WATCH_H
+//----------------------------------------------------------------------------------
+// Some Defines
+//----------------------------------------------------------------------------------
+#define WATCH_MAX_FILES         64
+#define WATCH_POLL_INTERVAL     0.5     // Seconds between modification time checks without inotify
+
+//----------------------------------------------------------------------------------
+// File Watch Functions Declaration
+//----------------------------------------------------------------------------------
+// Changes are picked up with inotify on Linux (directory watches, so editors that save by
+// renaming a temporary file are caught too), by polling modification times elsewhere
+void InitFileWatch(void);
+void UnloadFileWatch(void);
+void UpdateFileWatch(void);             // Once per frame, before anyone asks IsFileChanged()
+
+int WatchFile(const char *fileName);    // Returns watch id, -1 if the table is full
+void UnwatchFile(int watch);
+bool IsFileChanged(int watch);          // True once per change
+
+#endif